@@ -1,3 +1,4 @@
+using System.IO;
 using UnrealBuildTool;
 
 public class BarcodeScannerPlugin : ModuleRules
@@ -13,7 +14,8 @@ public class BarcodeScannerPlugin : ModuleRules
                 "CoreUObject",
                 "Engine",
                 "InputCore",
-                "HID"
+                "HID",
+                "UMG"
             }
         );
 
@@ -21,8 +23,13 @@ public class BarcodeScannerPlugin : ModuleRules
             new string[]
             {
                 "Slate",
-                "SlateCore"
+                "SlateCore",
+                "Json",
+                "JsonUtilities"
             }
         );
+
+        // Раскладка кольца разделяемой памяти общая с библиотекой чтения
+        PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "..", "ScanShmReader"));
     }
 } 
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "AwaitBarcodeScanAction.h"
+#include "BarcodeScanner.h"
+
+UAwaitBarcodeScanAction* UAwaitBarcodeScanAction::AwaitNextScan(ABarcodeScanner* Scanner, FBarcodeScanFilter Filter, float TimeoutSeconds)
+{
+    UAwaitBarcodeScanAction* Action = NewObject<UAwaitBarcodeScanAction>();
+    Action->Scanner = Scanner;
+    Action->Filter = Filter;
+    Action->TimeoutSeconds = TimeoutSeconds;
+    if (Scanner)
+    {
+        Action->RegisterWithGameInstance(Scanner);
+    }
+    return Action;
+}
+
+void UAwaitBarcodeScanAction::Activate()
+{
+    ABarcodeScanner* ScannerActor = Scanner.Get();
+    if (!ScannerActor)
+    {
+        HandleResult(TOptional<FBarcodeScanRecord>());
+        return;
+    }
+
+    TWeakObjectPtr<UAwaitBarcodeScanAction> WeakThis(this);
+    ScannerActor->AwaitNextScan(Filter, TimeoutSeconds).Next([WeakThis](const TOptional<FBarcodeScanRecord>& Result)
+    {
+        if (UAwaitBarcodeScanAction* Action = WeakThis.Get())
+        {
+            Action->HandleResult(Result);
+        }
+    });
+}
+
+void UAwaitBarcodeScanAction::HandleResult(const TOptional<FBarcodeScanRecord>& Result)
+{
+    if (Result.IsSet())
+    {
+        OnScanned.Broadcast(Result.GetValue());
+    }
+    else
+    {
+        OnTimeout.Broadcast(FBarcodeScanRecord());
+    }
+    SetReadyToDestroy();
+}
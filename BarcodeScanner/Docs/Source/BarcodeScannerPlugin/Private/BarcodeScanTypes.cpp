@@ -0,0 +1,32 @@
+#include "BarcodeScanTypes.h"
+#include "HAL/PlatformTime.h"
+
+FBarcodeScanRecord FBarcodeScanRecord::FromRawData(const FString& Data, const FString& DeviceId, int64 SequenceNumber)
+{
+    FBarcodeScanRecord Record;
+    Record.DeviceId = DeviceId;
+    Record.SequenceNumber = SequenceNumber;
+    Record.Timestamp = FDateTime::UtcNow();
+    Record.ReceiveTimeSeconds = FPlatformTime::Seconds();
+
+    // Префикс AIM: "]" + символ кода + модификатор
+    if (Data.Len() > 3 && Data[0] == TEXT(']'))
+    {
+        Record.Symbology = Data.Left(3);
+        Record.Code = Data.RightChop(3);
+    }
+    else
+    {
+        Record.Code = Data;
+    }
+
+    return Record;
+}
+
+bool FBarcodeScanFilter::Matches(const FBarcodeScanRecord& Record) const
+{
+    // Идентификаторы AIM различают регистр: "]E0" - EAN/UPC, "]e0" - GS1 DataBar
+    return (Symbology.IsEmpty() || Record.Symbology.Equals(Symbology, ESearchCase::CaseSensitive))
+        && (Prefix.IsEmpty() || Record.Code.StartsWith(Prefix, ESearchCase::CaseSensitive))
+        && (DeviceId.IsEmpty() || Record.DeviceId == DeviceId);
+}
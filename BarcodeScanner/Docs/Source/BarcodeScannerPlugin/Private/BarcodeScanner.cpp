@@ -1,22 +1,103 @@
 #include "BarcodeScanner.h"
 #include "HID.h"
+#include "ScanTraceReplayDevice.h"
+#include "KeyboardWedgeScannerDevice.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+#include "JsonObjectConverter.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
 
 ABarcodeScanner::ABarcodeScanner()
 {
     PrimaryActorTick.bCanEverTick = true;
     bIsScannerActive = false;
+    Pipeline = MakeShared<FScanPipeline>();
 }
 
 void ABarcodeScanner::BeginPlay()
 {
     Super::BeginPlay();
+    Pipeline->OnScanCompleted.BindUObject(this, &ABarcodeScanner::DispatchScan);
+    IngestQueue.Configure(IngestQueueCapacity, OverloadPolicy, BlockReaderTimeoutSeconds);
+    Analytics.Configure(AnalyticsWindowSeconds);
     InitializeScanner();
+
+    if (bEnableSharedMemoryExport)
+    {
+        ShmExporter.Open(SharedMemoryName, SharedMemorySlotCount);
+    }
+
+    if (bEnableAnalytics && !AnalyticsDumpPath.IsEmpty())
+    {
+        AnalyticsWriter = MakeShared<FScanAnalyticsFileWriter>(AnalyticsDumpPath);
+        GetWorldTimerManager().SetTimer(AnalyticsDumpHandle, this, &ABarcodeScanner::DumpAnalytics, AnalyticsDumpIntervalSeconds, true);
+    }
+
+    // Нагрузочные прогоны в CI: -ScanReplay=<файл> [-ScanReplaySpeed=<множитель>]
+    FString ReplayPath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("ScanReplay="), ReplayPath))
+    {
+        float ReplaySpeed = 1.0f;
+        FParse::Value(FCommandLine::Get(), TEXT("ScanReplaySpeed="), ReplaySpeed);
+        StartTraceReplay(ReplayPath, ReplaySpeed);
+    }
+}
+
+void ABarcodeScanner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Устройство закрываем первым: после Close обратные вызовы в актёр не приходят
+    if (Device)
+    {
+        Device->Close();
+    }
+    TraceRecorder.Close();
+
+    if (AnalyticsDumpHandle.IsValid())
+    {
+        GetWorldTimerManager().ClearTimer(AnalyticsDumpHandle);
+        DumpAnalytics();
+    }
+    if (AnalyticsWriter)
+    {
+        // Последний снимок дописываем здесь же, не полагаясь на пул потоков при выходе
+        AnalyticsWriter->Flush();
+        AnalyticsWriter.Reset();
+    }
+
+    IngestQueue.Shutdown();
+    Pipeline->Shutdown();
+    ShmExporter.Close();
+
+    // Ожидающие получают пустой результат, чтобы не зависнуть навсегда
+    TArray<FScanWaiter> Cancelled = MoveTemp(Waiters);
+    for (FScanWaiter& Waiter : Cancelled)
+    {
+        GetWorldTimerManager().ClearTimer(Waiter.TimeoutHandle);
+        Waiter.Promise->SetValue(TOptional<FBarcodeScanRecord>());
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ABarcodeScanner::BeginDestroy()
+{
+    // Страховка для актёров, удалённых без EndPlay: поток устройства не должен пережить актёр
+    if (Device)
+    {
+        Device->Close();
+    }
+    Super::BeginDestroy();
 }
 
 void ABarcodeScanner::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    // Сканирования с фоновых потоков и оставшиеся с прошлого кадра
+    DrainIngestQueue();
+
     if (bIsScannerActive)
     {
         // Здесь будет код для чтения данных со сканера
@@ -26,14 +107,80 @@ void ABarcodeScanner::Tick(float DeltaTime)
 
 void ABarcodeScanner::StartScanner()
 {
+    if (!bIsScannerActive && Device)
+    {
+        // Идентификатор запрашиваем при каждом событии: воспроизведение узнаёт его только в Open.
+        // Сырой указатель безопасен: Close ждёт завершения потока устройства и вызывается
+        // из StopScanner, EndPlay и BeginDestroy раньше, чем актёр может быть удалён
+        IBarcodeScannerDevice* RawDevice = Device.Get();
+        const bool bOpened = Device->Open([this, RawDevice](const FScanRawEvent& Event)
+        {
+            HandleRawInput(Event, RawDevice->GetDeviceId());
+        });
+
+        if (!bOpened)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[BarcodeScanner] Failed to open device %s"), *Device->GetDeviceId());
+            return;
+        }
+    }
     bIsScannerActive = true;
 }
 
 void ABarcodeScanner::StopScanner()
 {
+    if (bIsScannerActive && Device)
+    {
+        Device->Close();
+    }
     bIsScannerActive = false;
 }
 
+void ABarcodeScanner::SetDevice(TSharedPtr<IBarcodeScannerDevice> InDevice)
+{
+    const bool bWasActive = bIsScannerActive;
+    StopScanner();
+    Device = MoveTemp(InDevice);
+    if (bWasActive)
+    {
+        StartScanner();
+    }
+}
+
+void ABarcodeScanner::HandleRawInput(const FScanRawEvent& Event, const FString& SourceDeviceId)
+{
+    TraceRecorder.Record(Event);
+
+    FString Data;
+    bool bCompleted = false;
+    {
+        FScopeLock ScopeLock(&InputAssemblerLock);
+        bCompleted = InputAssembler.Feed(Event, Data);
+    }
+
+    if (bCompleted)
+    {
+        EnqueueScanData(Data, SourceDeviceId);
+    }
+}
+
+bool ABarcodeScanner::StartTraceRecording(const FString& FilePath)
+{
+    return TraceRecorder.Open(FilePath, Device ? Device->GetDeviceId() : DeviceId);
+}
+
+void ABarcodeScanner::StopTraceRecording()
+{
+    TraceRecorder.Close();
+}
+
+bool ABarcodeScanner::StartTraceReplay(const FString& FilePath, float SpeedMultiplier)
+{
+    SetDevice(MakeShared<FScanTraceReplayDevice>(FilePath, SpeedMultiplier));
+    StartScanner();
+    return bIsScannerActive;
+}
+
 FString ABarcodeScanner::GetLastScannedCode()
 {
     return LastScannedCode;
@@ -41,12 +188,173 @@ FString ABarcodeScanner::GetLastScannedCode()
 
 void ABarcodeScanner::InitializeScanner()
 {
-    // Здесь будет код инициализации сканера
-    // Пока что это заглушка
+    // Устройство, заданное из C++ до BeginPlay, не подменяем
+    if (!Device && bUseKeyboardWedge)
+    {
+        SetDevice(MakeShared<FKeyboardWedgeScannerDevice>(DeviceId, bConsumeKeyboardWedgeInput));
+    }
 }
 
 void ABarcodeScanner::ProcessScannedData(const FString& Data)
 {
-    LastScannedCode = Data;
-    OnBarcodeScanned(Data);
+    EnqueueScanData(Data, DeviceId);
+
+    // На игровом потоке выдаём сразу, не дожидаясь следующего кадра
+    DrainIngestQueue();
+}
+
+bool ABarcodeScanner::EnqueueScanData(const FString& Data, const FString& SourceDeviceId)
+{
+    const FBarcodeScanRecord Record = FBarcodeScanRecord::FromRawData(Data, SourceDeviceId, NextSequenceNumber++);
+    if (!IngestQueue.Enqueue(Record))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[BarcodeScanner] Ingest queue is full, scan %lld dropped"), Record.SequenceNumber);
+        return false;
+    }
+    return true;
+}
+
+FScanAnalyticsSnapshot ABarcodeScanner::GetAnalyticsSnapshot() const
+{
+    return Analytics.GetSnapshot(Analytics.GetWallClockSeconds(), AnalyticsSlidingWindowSeconds);
+}
+
+float ABarcodeScanner::GetItemScanRate(const FString& Code) const
+{
+    return Analytics.EstimateRate(Code, Analytics.GetWallClockSeconds());
+}
+
+void ABarcodeScanner::DumpAnalytics()
+{
+    FString Line;
+    if (!AnalyticsWriter || !FJsonObjectConverter::UStructToJsonObjectString(GetAnalyticsSnapshot(), Line, 0, 0, 0, nullptr, false))
+    {
+        return;
+    }
+
+    // Запись в файл не задерживает игровой поток; строки ложатся в порядке снимков
+    AnalyticsWriter->Append(Line);
+}
+
+void ABarcodeScanner::DrainIngestQueue()
+{
+    // Порог проверяется по пиковой глубине, чтобы не пропустить всплески между кадрами
+    const FScanIngestStats Stats = IngestQueue.GetStats();
+    const int32 PeakDepth = IngestQueue.ConsumePeakDepth();
+    const int32 HighWatermark = FMath::CeilToInt(Stats.QueueCapacity * HighWatermarkPercent / 100.0f);
+    if (!bHighWatermarkRaised && PeakDepth >= HighWatermark)
+    {
+        bHighWatermarkRaised = true;
+        OnScanQueueHighWatermark(Stats);
+    }
+    else if (bHighWatermarkRaised && Stats.QueueDepth < HighWatermark / 2)
+    {
+        bHighWatermarkRaised = false;
+    }
+
+    int32 Budget = MaxDispatchPerTick > 0 ? MaxDispatchPerTick : MAX_int32;
+    FBarcodeScanRecord Record;
+    while (Budget-- > 0)
+    {
+        // Заполненный конвейер оставляет сканирование в очереди приёма
+        if (Pipeline->HasStages())
+        {
+            if (!IngestQueue.TryConsumeFront([this](const FBarcodeScanRecord& Front) { return Pipeline->Submit(Front); }))
+            {
+                break;
+            }
+        }
+        else if (!IngestQueue.PeekFront(Record))
+        {
+            break;
+        }
+        // Извлекаем до выдачи: обработчик в Blueprint может снова вызвать разбор очереди.
+        // Если сканирование успели вытеснить, оно уже учтено как потерянное
+        else if (IngestQueue.PopFront(Record.SequenceNumber))
+        {
+            DispatchScan(Record);
+        }
+    }
+
+    IngestQueue.MarkRemainingDelayed();
+}
+
+void ABarcodeScanner::DispatchScan(const FBarcodeScanRecord& Record)
+{
+    LastScannedCode = Record.Code;
+    LastScanRecord = Record;
+
+    // Учитываются только выданные сканирования: вытесненные и отклонённые очередью в статистику не попадают
+    if (bEnableAnalytics)
+    {
+        Analytics.Ingest(Record);
+    }
+
+    OnBarcodePreDispatch.Broadcast(Record);
+    OnBarcodeScanned(Record.Code);
+    ShmExporter.Publish(Record);
+    OnBarcodeScannedNative.Broadcast(Record);
+    ResolveWaiters(Record);
+}
+
+TFuture<TOptional<FBarcodeScanRecord>> ABarcodeScanner::AwaitNextScan(const FBarcodeScanFilter& Filter, float TimeoutSeconds)
+{
+    check(IsInGameThread());
+
+    TSharedRef<TPromise<TOptional<FBarcodeScanRecord>>> Promise = MakeShared<TPromise<TOptional<FBarcodeScanRecord>>>();
+    TFuture<TOptional<FBarcodeScanRecord>> Future = Promise->GetFuture();
+
+    const uint64 WaiterId = NextWaiterId++;
+    FTimerHandle TimeoutHandle;
+    if (TimeoutSeconds > 0.0f)
+    {
+        GetWorldTimerManager().SetTimer(TimeoutHandle,
+            FTimerDelegate::CreateUObject(this, &ABarcodeScanner::TimeoutWaiter, WaiterId),
+            TimeoutSeconds, false);
+    }
+
+    Waiters.Add({ WaiterId, Filter, TimeoutHandle, Promise });
+    return Future;
+}
+
+void ABarcodeScanner::ResolveWaiters(const FBarcodeScanRecord& Record)
+{
+    if (Waiters.Num() == 0)
+    {
+        return;
+    }
+
+    // Сначала забираем подходящих, потом разрешаем: продолжения могут добавить новых ожидающих
+    TArray<FScanWaiter> Matched;
+    for (int32 Index = 0; Index < Waiters.Num();)
+    {
+        if (Waiters[Index].Filter.Matches(Record))
+        {
+            Matched.Add(MoveTemp(Waiters[Index]));
+            Waiters.RemoveAt(Index);
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+
+    for (FScanWaiter& Waiter : Matched)
+    {
+        GetWorldTimerManager().ClearTimer(Waiter.TimeoutHandle);
+        Waiter.Promise->SetValue(TOptional<FBarcodeScanRecord>(Record));
+    }
+}
+
+void ABarcodeScanner::TimeoutWaiter(uint64 WaiterId)
+{
+    const int32 Index = Waiters.IndexOfByPredicate([WaiterId](const FScanWaiter& Waiter) { return Waiter.Id == WaiterId; });
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    TSharedRef<TPromise<TOptional<FBarcodeScanRecord>>> Promise = Waiters[Index].Promise;
+    Waiters.RemoveAt(Index);
+    Promise->SetValue(TOptional<FBarcodeScanRecord>());
 } 
\ No newline at end of file
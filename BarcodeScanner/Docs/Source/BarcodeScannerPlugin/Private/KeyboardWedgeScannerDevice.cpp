@@ -0,0 +1,123 @@
+#include "KeyboardWedgeScannerDevice.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/PlatformTime.h"
+
+// Препроцессор ввода Slate: видит символы раньше виджетов и игрового ввода
+class FKeyboardWedgeInputProcessor : public IInputProcessor
+{
+public:
+    FKeyboardWedgeInputProcessor(FScanRawEventSink InSink, bool bInConsumeInput)
+        : Sink(MoveTemp(InSink))
+        , bConsumeInput(bInConsumeInput)
+    {
+    }
+
+    virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override
+    {
+    }
+
+    virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+    {
+        // Enter приходит нажатием клавиши, а не символом, на всех платформах одинаково
+        if (InKeyEvent.GetKey() == EKeys::Enter)
+        {
+            Emit(TEXT('\r'));
+            return bConsumeInput;
+        }
+        return false;
+    }
+
+    virtual bool HandleKeyCharEvent(FSlateApplication& SlateApp, const FCharacterEvent& InCharacterEvent) override
+    {
+        const TCHAR Character = InCharacterEvent.GetCharacter();
+        if (Character == TEXT('\r') || Character == TEXT('\n'))
+        {
+            // Конец кода уже отправлен из HandleKeyDownEvent
+            return bConsumeInput;
+        }
+        if (Character < 0x20)
+        {
+            return false;
+        }
+
+        Emit(Character);
+        return bConsumeInput;
+    }
+
+    virtual const TCHAR* GetDebugName() const override { return TEXT("KeyboardWedgeScanner"); }
+
+    // Отключение на игровом потоке: после возврата события в приёмник не попадают
+    void Detach()
+    {
+        Sink = nullptr;
+    }
+
+private:
+    void Emit(TCHAR Character)
+    {
+        if (!Sink)
+        {
+            return;
+        }
+
+        FScanRawEvent Event;
+        Event.Kind = EScanRawEventKind::Keystroke;
+        Event.TimeSeconds = FPlatformTime::Seconds();
+
+        const TCHAR Text[2] = { Character, TEXT('\0') };
+        const FTCHARToUTF8 Utf8(Text);
+        Event.Payload.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        Sink(Event);
+    }
+
+    FScanRawEventSink Sink;
+    bool bConsumeInput;
+};
+
+FKeyboardWedgeScannerDevice::FKeyboardWedgeScannerDevice(const FString& InDeviceId, bool bInConsumeInput)
+    : DeviceId(InDeviceId)
+    , bConsumeInput(bInConsumeInput)
+{
+}
+
+FKeyboardWedgeScannerDevice::~FKeyboardWedgeScannerDevice()
+{
+    Close();
+}
+
+bool FKeyboardWedgeScannerDevice::Open(FScanRawEventSink InSink)
+{
+    check(IsInGameThread());
+    Close();
+
+    // В headless-сборке (-nullrhi) Slate не создаётся; там используется воспроизведение записи
+    if (!FSlateApplication::IsInitialized())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[BarcodeScanner] Keyboard wedge input needs Slate, device %s is not available"), *DeviceId);
+        return false;
+    }
+
+    Processor = MakeShared<FKeyboardWedgeInputProcessor>(MoveTemp(InSink), bConsumeInput);
+    if (!FSlateApplication::Get().RegisterInputPreProcessor(Processor, 0))
+    {
+        Processor.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FKeyboardWedgeScannerDevice::Close()
+{
+    if (!Processor)
+    {
+        return;
+    }
+
+    Processor->Detach();
+    if (FSlateApplication::IsInitialized())
+    {
+        FSlateApplication::Get().UnregisterInputPreProcessor(Processor);
+    }
+    Processor.Reset();
+}
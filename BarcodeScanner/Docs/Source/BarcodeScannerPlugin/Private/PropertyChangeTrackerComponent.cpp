@@ -0,0 +1,193 @@
+#include "PropertyChangeTrackerComponent.h"
+#include "GameFramework/Actor.h"
+#include "UObject/UnrealType.h"
+
+UPropertyChangeTrackerComponent::UPropertyChangeTrackerComponent()
+{
+    // Тик включается только при наличии изменений и идёт после всей логики кадра
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UPropertyChangeTrackerComponent::BeginPlay()
+{
+    Super::BeginPlay();
+    BuildTrackedEntries();
+
+    // Изменения до BeginPlay не с чем сравнить: значение до них неизвестно
+    TArray<FName> Pending = MoveTemp(PendingDirty);
+    for (const FName& PropertyName : Pending)
+    {
+        if (const int32* Index = PropertyIndices.Find(PropertyName))
+        {
+            ForcedBits[*Index] = true;
+        }
+        MarkPropertyDirty(PropertyName);
+    }
+}
+
+void UPropertyChangeTrackerComponent::BeginDestroy()
+{
+    ReleaseSnapshot();
+    Super::BeginDestroy();
+}
+
+void UPropertyChangeTrackerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    FlushChanges();
+}
+
+void UPropertyChangeTrackerComponent::BuildTrackedEntries()
+{
+    ReleaseSnapshot();
+    Entries.Reset();
+    PropertyIndices.Reset();
+    bEntriesBuilt = true;
+
+    AActor* Owner = GetOwner();
+    if (!Owner)
+    {
+        return;
+    }
+
+    // Раскладываем снимки свойств в одном буфере с учётом выравнивания
+    int32 TotalSize = 0;
+    for (TFieldIterator<FProperty> It(Owner->GetClass()); It; ++It)
+    {
+        FProperty* Property = *It;
+        const bool bTracked = TrackedProperties.Num() > 0
+            ? TrackedProperties.Contains(Property->GetFName())
+            : Property->HasAnyPropertyFlags(CPF_BlueprintVisible) && !AActor::StaticClass()->IsChildOf(Property->GetOwnerClass());
+        if (!bTracked)
+        {
+            continue;
+        }
+
+        TotalSize = Align(TotalSize, Property->GetMinAlignment());
+        PropertyIndices.Add(Property->GetFName(), Entries.Add({ Property, TotalSize }));
+        TotalSize += Property->GetSize();
+    }
+
+    if (Entries.Num() == 0)
+    {
+        return;
+    }
+
+    SnapshotData = static_cast<uint8*>(FMemory::Malloc(TotalSize, 16));
+    PreviousData = static_cast<uint8*>(FMemory::Malloc(TotalSize, 16));
+    for (const FTrackedEntry& Entry : Entries)
+    {
+        Entry.Property->InitializeValue(SnapshotData + Entry.SnapshotOffset);
+        Entry.Property->InitializeValue(PreviousData + Entry.SnapshotOffset);
+        Entry.Property->CopyCompleteValue(SnapshotData + Entry.SnapshotOffset, Entry.Property->ContainerPtrToValuePtr<void>(Owner));
+        Entry.Property->CopyCompleteValue(PreviousData + Entry.SnapshotOffset, SnapshotData + Entry.SnapshotOffset);
+    }
+
+    DirtyBits.Init(false, Entries.Num());
+    ForcedBits.Init(false, Entries.Num());
+}
+
+void UPropertyChangeTrackerComponent::ReleaseSnapshot()
+{
+    for (uint8* Data : { SnapshotData, PreviousData })
+    {
+        if (!Data)
+        {
+            continue;
+        }
+        for (const FTrackedEntry& Entry : Entries)
+        {
+            Entry.Property->DestroyValue(Data + Entry.SnapshotOffset);
+        }
+        FMemory::Free(Data);
+    }
+    SnapshotData = nullptr;
+    PreviousData = nullptr;
+    bHasDirty = false;
+}
+
+const FProperty* UPropertyChangeTrackerComponent::FindPreviousValue(FName PropertyName, const uint8*& OutData) const
+{
+    const int32* Index = PropertyIndices.Find(PropertyName);
+    if (!Index || !PreviousData)
+    {
+        return nullptr;
+    }
+
+    OutData = PreviousData + Entries[*Index].SnapshotOffset;
+    return Entries[*Index].Property;
+}
+
+void UPropertyChangeTrackerComponent::MarkPropertyDirty(FName PropertyName)
+{
+    // До BeginPlay список свойств ещё не построен
+    if (!bEntriesBuilt)
+    {
+        PendingDirty.AddUnique(PropertyName);
+        return;
+    }
+
+    const int32* Index = PropertyIndices.Find(PropertyName);
+    if (!Index)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[PropertyChangeTracker] Property %s is not tracked on %s"),
+            *PropertyName.ToString(), GetOwner() ? *GetOwner()->GetName() : TEXT("None"));
+        return;
+    }
+
+    DirtyBits[*Index] = true;
+    if (!bHasDirty)
+    {
+        bHasDirty = true;
+        SetComponentTickEnabled(true);
+    }
+}
+
+void UPropertyChangeTrackerComponent::FlushChanges()
+{
+    if (!bHasDirty)
+    {
+        return;
+    }
+    bHasDirty = false;
+    SetComponentTickEnabled(false);
+
+    AActor* Owner = GetOwner();
+    if (!Owner || !SnapshotData)
+    {
+        return;
+    }
+
+    // Сравниваем только помеченные свойства со снимком прошлой рассылки
+    TArray<FName> ChangedProperties;
+    for (TConstSetBitIterator<> It(DirtyBits); It; ++It)
+    {
+        const FTrackedEntry& Entry = Entries[It.GetIndex()];
+        FProperty* Property = Entry.Property;
+        uint8* Snapshot = SnapshotData + Entry.SnapshotOffset;
+        const uint8* Current = Property->ContainerPtrToValuePtr<uint8>(Owner);
+
+        bool bIdentical = true;
+        for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim && bIdentical; ++ArrayIndex)
+        {
+            bIdentical = Property->Identical(Snapshot + ArrayIndex * Property->ElementSize, Current + ArrayIndex * Property->ElementSize);
+        }
+
+        // Записи, вернувшие исходное значение, в событие не попадают
+        if (!bIdentical || ForcedBits[It.GetIndex()])
+        {
+            Property->CopyCompleteValue(PreviousData + Entry.SnapshotOffset, Snapshot);
+            Property->CopyCompleteValue(Snapshot, Current);
+            ChangedProperties.Add(Property->GetFName());
+        }
+    }
+    DirtyBits.SetRange(0, DirtyBits.Num(), false);
+    ForcedBits.SetRange(0, ForcedBits.Num(), false);
+
+    if (ChangedProperties.Num() > 0)
+    {
+        OnPropertiesChanged.Broadcast(ChangedProperties);
+    }
+}
@@ -6,11 +6,16 @@ AReflectionExample::AReflectionExample()
     ExampleNumber = 0;
     PrivateNumber = 0;
     ReadOnlyString = TEXT("Это строка только для чтения");
+
+    // Отслеживаем изменения свойств через рефлексию
+    ChangeTracker = CreateDefaultSubobject<UPropertyChangeTrackerComponent>(TEXT("ChangeTracker"));
 }
 
 void AReflectionExample::BeginPlay()
 {
     Super::BeginPlay();
+
+    ChangeTracker->OnPropertiesChanged.AddDynamic(this, &AReflectionExample::HandleTrackedPropertiesChanged);
     
     // Вызываем событие при старте
     OnNumberChanged(0, ExampleNumber);
@@ -18,12 +23,18 @@ void AReflectionExample::BeginPlay()
 
 void AReflectionExample::SetExampleNumber(int32 NewNumber)
 {
-    // Сохраняем старое значение
-    int32 OldNumber = ExampleNumber;
-    
-    // Устанавливаем новое значение
-    ExampleNumber = NewNumber;
-    
-    // Вызываем событие
-    OnNumberChanged(OldNumber, NewNumber);
-} 
\ No newline at end of file
+    // Одинаковые значения пропускаются, повторные записи за кадр схлопываются
+    ChangeTracker->SetTrackedValue(ExampleNumber, NewNumber, GET_MEMBER_NAME_CHECKED(AReflectionExample, ExampleNumber));
+}
+
+void AReflectionExample::HandleTrackedPropertiesChanged(const TArray<FName>& ChangedProperties)
+{
+    // Старое значение берём из снимка трекера
+    if (ChangedProperties.Contains(GET_MEMBER_NAME_CHECKED(AReflectionExample, ExampleNumber)))
+    {
+        const int32* OldNumber = ChangeTracker->GetPreviousValue<int32>(GET_MEMBER_NAME_CHECKED(AReflectionExample, ExampleNumber));
+        OnNumberChanged(OldNumber ? *OldNumber : 0, ExampleNumber);
+    }
+
+    OnPropertiesChanged(ChangedProperties);
+}
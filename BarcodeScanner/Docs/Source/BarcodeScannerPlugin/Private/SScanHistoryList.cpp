@@ -0,0 +1,167 @@
+#include "SScanHistoryList.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Views/STableRow.h"
+
+namespace
+{
+    // Строка истории: текст обновляется на месте, без пересоздания виджетов
+    class SScanHistoryRow : public STableRow<TSharedPtr<int32>>
+    {
+    public:
+        SLATE_BEGIN_ARGS(SScanHistoryRow) {}
+        SLATE_END_ARGS()
+
+        void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+        {
+            STableRow<TSharedPtr<int32>>::Construct(
+                STableRow<TSharedPtr<int32>>::FArguments()
+                [
+                    SNew(SHorizontalBox)
+                    + SHorizontalBox::Slot()
+                    .AutoWidth()
+                    .Padding(4.0f, 2.0f)
+                    [
+                        SAssignNew(TimeText, STextBlock)
+                    ]
+                    + SHorizontalBox::Slot()
+                    .FillWidth(1.0f)
+                    .Padding(4.0f, 2.0f)
+                    [
+                        SAssignNew(CodeText, STextBlock)
+                    ]
+                ],
+                OwnerTable);
+        }
+
+        void SetEntry(const FScanHistoryEntry* Entry)
+        {
+            // Новый FText всегда инвалидирует STextBlock, поэтому сравниваем исходные данные
+            const FDateTime Time = Entry ? Entry->Time : FDateTime();
+            const FString& Code = Entry ? Entry->Code : FString();
+            if (bHasEntry == (Entry != nullptr) && Time == ShownTime && Code == ShownCode)
+            {
+                return;
+            }
+
+            bHasEntry = Entry != nullptr;
+            ShownTime = Time;
+            ShownCode = Code;
+            TimeText->SetText(Entry ? FText::FromString(Time.ToString(TEXT("%H:%M:%S"))) : FText::GetEmpty());
+            CodeText->SetText(Entry ? FText::FromString(Code) : FText::GetEmpty());
+        }
+
+    private:
+        TSharedPtr<STextBlock> TimeText;
+        TSharedPtr<STextBlock> CodeText;
+
+        // Показанные значения; начальное состояние заставляет первый SetEntry заполнить текст
+        bool bHasEntry = true;
+        FDateTime ShownTime;
+        FString ShownCode;
+    };
+}
+
+void SScanHistoryList::Construct(const FArguments& InArgs)
+{
+    const int32 Capacity = FMath::Max(InArgs._Capacity, 1);
+
+    // Все буферы выделяются один раз
+    Ring.SetNum(Capacity);
+    SlotPool.Reserve(Capacity);
+    for (int32 Index = 0; Index < Capacity; ++Index)
+    {
+        SlotPool.Add(MakeShared<int32>(Index));
+    }
+    VisibleSlots.Reserve(Capacity);
+
+    ChildSlot
+    [
+        SAssignNew(ListView, SListView<FRowSlot>)
+        .ListItemsSource(&VisibleSlots)
+        .OnGenerateRow(this, &SScanHistoryList::OnGenerateRow)
+        .SelectionMode(ESelectionMode::None)
+    ];
+}
+
+void SScanHistoryList::AddScan(const FString& Code)
+{
+    AddScan(Code, FDateTime::Now());
+}
+
+void SScanHistoryList::AddScan(const FString& Code, const FDateTime& Time)
+{
+    FScanHistoryEntry& Entry = Ring[Head];
+    Entry.Code = Code;
+    Entry.Time = Time;
+
+    Head = (Head + 1) % Ring.Num();
+    Count = FMath::Min(Count + 1, Ring.Num());
+
+    // Сколько бы сканирований ни пришло за кадр, обновление одно
+    if (!bRefreshPending)
+    {
+        bRefreshPending = true;
+        RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SScanHistoryList::RefreshVisibleRows));
+    }
+}
+
+void SScanHistoryList::ClearHistory()
+{
+    Head = 0;
+    Count = 0;
+    VisibleSlots.Reset();
+    ListView->RequestListRefresh();
+}
+
+const FScanHistoryEntry* SScanHistoryList::GetEntry(int32 SlotIndex) const
+{
+    if (SlotIndex < 0 || SlotIndex >= Count)
+    {
+        return nullptr;
+    }
+
+    // Слот 0 - самое новое сканирование
+    const int32 Capacity = Ring.Num();
+    return &Ring[(Head - 1 - SlotIndex + Capacity) % Capacity];
+}
+
+void SScanHistoryList::ApplyEntryToRow(const TSharedPtr<ITableRow>& Row, int32 SlotIndex) const
+{
+    if (Row.IsValid())
+    {
+        StaticCastSharedPtr<SScanHistoryRow>(Row)->SetEntry(GetEntry(SlotIndex));
+    }
+}
+
+TSharedRef<ITableRow> SScanHistoryList::OnGenerateRow(FRowSlot Slot, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    TSharedRef<SScanHistoryRow> Row = SNew(SScanHistoryRow, OwnerTable);
+    Row->SetEntry(GetEntry(*Slot));
+    return Row;
+}
+
+EActiveTimerReturnType SScanHistoryList::RefreshVisibleRows(double InCurrentTime, float InDeltaTime)
+{
+    bRefreshPending = false;
+
+    // Пока буфер не заполнен, источник растёт за счёт готовых элементов пула
+    if (VisibleSlots.Num() != Count)
+    {
+        while (VisibleSlots.Num() < Count)
+        {
+            VisibleSlots.Add(SlotPool[VisibleSlots.Num()]);
+        }
+        ListView->RequestListRefresh();
+    }
+
+    // Обновляем текст только у сгенерированных (видимых) строк
+    const int32 FirstIndex = FMath::Max(FMath::FloorToInt(ListView->GetScrollOffset()), 0);
+    const int32 LastIndex = FMath::Min(FirstIndex + ListView->GetNumGeneratedChildren(), VisibleSlots.Num());
+    for (int32 Index = FirstIndex; Index < LastIndex; ++Index)
+    {
+        ApplyEntryToRow(ListView->WidgetFromItem(VisibleSlots[Index]), Index);
+    }
+
+    return EActiveTimerReturnType::Stop;
+}
@@ -0,0 +1,447 @@
+#include "ScanAnalytics.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    uint64 HashString(const FString& Value)
+    {
+        const uint64 Hash = CityHash64(reinterpret_cast<const char*>(*Value), Value.Len() * sizeof(TCHAR));
+        return Hash != 0 ? Hash : 1;
+    }
+
+    const FDateTime& UnixEpoch()
+    {
+        static const FDateTime Epoch(1970, 1, 1);
+        return Epoch;
+    }
+
+    FDateTime FromUnixSeconds(double Seconds)
+    {
+        return UnixEpoch() + FTimespan::FromSeconds(Seconds);
+    }
+
+    // Занимает корзину под новую метку; false - событие старше корзины и не учитывается
+    template <typename ResetFunctionType>
+    bool AcquireBucket(std::atomic<int64>& Stamp, int64 Value, ResetFunctionType&& ResetCounters)
+    {
+        int64 Current = Stamp.load(std::memory_order_acquire);
+        while (Current < Value)
+        {
+            if (Stamp.compare_exchange_weak(Current, Value, std::memory_order_acq_rel))
+            {
+                ResetCounters();
+                return true;
+            }
+        }
+        return Current == Value;
+    }
+}
+
+FScanAnalytics::FScanAnalytics()
+{
+    HeavyHitters.Reserve(TopK);
+    PreviousHeavyHitters.Reserve(TopK);
+}
+
+void FScanAnalytics::Configure(float InWindowSeconds)
+{
+    WindowSeconds = FMath::Max(InWindowSeconds, 1.0f);
+    WallClockOffset = (FDateTime::UtcNow() - UnixEpoch()).GetTotalSeconds() - FPlatformTime::Seconds();
+}
+
+double FScanAnalytics::GetWallClockSeconds() const
+{
+    return FPlatformTime::Seconds() + WallClockOffset;
+}
+
+void FScanAnalytics::Ingest(const FBarcodeScanRecord& Record)
+{
+    Ingest(Record.Code, Record.DeviceId, Record.ReceiveTimeSeconds + WallClockOffset);
+}
+
+void FScanAnalytics::Ingest(const FString& Code, const FString& DeviceId, double TimeSeconds)
+{
+    // Шард закрепляется за потоком при первом вызове
+    static std::atomic<int32> NextShard { 0 };
+    thread_local const int32 ShardIndex = NextShard.fetch_add(1, std::memory_order_relaxed) % NumShards;
+    FShard& Shard = Shards[ShardIndex];
+
+    Shard.Total.fetch_add(1, std::memory_order_relaxed);
+
+    const int64 Second = FMath::FloorToInt64(TimeSeconds);
+    FSecondBucket& SecondBucket = Shard.Seconds[Second & (NumSecondBuckets - 1)];
+    if (AcquireBucket(SecondBucket.Second, Second, [&SecondBucket]() { SecondBucket.Count.store(0, std::memory_order_relaxed); }))
+    {
+        SecondBucket.Count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const int64 Window = GetWindowIndex(TimeSeconds);
+    FWindowBucket& WindowBucket = Shard.Windows[Window % NumWindowBuckets];
+    const bool bWindowAcquired = AcquireBucket(WindowBucket.Window, Window, [&WindowBucket]()
+    {
+        WindowBucket.Total.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint32>& Counter : WindowBucket.PerDevice)
+        {
+            Counter.store(0, std::memory_order_relaxed);
+        }
+    });
+    if (bWindowAcquired)
+    {
+        WindowBucket.Total.fetch_add(1, std::memory_order_relaxed);
+        WindowBucket.PerDevice[FindDeviceSlot(DeviceId)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (Window > SketchWindow.load(std::memory_order_acquire))
+    {
+        RollSketch(Window);
+    }
+
+    const uint64 CodeHash = HashString(Code);
+    const uint32 Estimate = AddToSketch(CodeHash);
+    if (Estimate > HeavyThreshold.load(std::memory_order_relaxed))
+    {
+        UpdateHeavyHitters(Code, CodeHash, Estimate);
+    }
+}
+
+int64 FScanAnalytics::EstimateCount(const FString& Code) const
+{
+    return QuerySketch(HashString(Code));
+}
+
+float FScanAnalytics::EstimateRate(const FString& Code, double NowSeconds) const
+{
+    const int64 Window = GetWindowIndex(NowSeconds);
+    if (SketchWindow.load(std::memory_order_acquire) != Window)
+    {
+        return 0.0f;
+    }
+
+    const double Elapsed = FMath::Max(NowSeconds - Window * (double)WindowSeconds, 1.0);
+    return (float)(EstimateCount(Code) / Elapsed);
+}
+
+FScanAnalyticsSnapshot FScanAnalytics::GetSnapshot(double NowSeconds, float SlidingWindowSeconds) const
+{
+    FScanAnalyticsSnapshot Snapshot;
+
+    const int32 SlidingSeconds = FMath::Clamp(FMath::CeilToInt(SlidingWindowSeconds), 1, NumSecondBuckets - 1);
+    const int64 NowSecond = FMath::FloorToInt64(NowSeconds);
+    const int64 FirstSecond = NowSecond - SlidingSeconds + 1;
+    const int64 Window = GetWindowIndex(NowSeconds);
+
+    uint32 DeviceCurrent[MaxDevices + 1] = {};
+    uint32 DevicePrevious[MaxDevices + 1] = {};
+
+    for (const FShard& Shard : Shards)
+    {
+        Snapshot.TotalScans += Shard.Total.load(std::memory_order_relaxed);
+
+        for (const FSecondBucket& Bucket : Shard.Seconds)
+        {
+            const int64 Second = Bucket.Second.load(std::memory_order_acquire);
+            if (Second >= FirstSecond && Second <= NowSecond)
+            {
+                Snapshot.SlidingWindowScans += Bucket.Count.load(std::memory_order_relaxed);
+            }
+        }
+
+        for (const FWindowBucket& Bucket : Shard.Windows)
+        {
+            const int64 BucketWindow = Bucket.Window.load(std::memory_order_acquire);
+            uint32* DeviceCounts = BucketWindow == Window ? DeviceCurrent : (BucketWindow == Window - 1 ? DevicePrevious : nullptr);
+            if (!DeviceCounts)
+            {
+                continue;
+            }
+
+            (BucketWindow == Window ? Snapshot.CurrentWindowScans : Snapshot.PreviousWindowScans) += Bucket.Total.load(std::memory_order_relaxed);
+            for (int32 Slot = 0; Slot <= MaxDevices; ++Slot)
+            {
+                DeviceCounts[Slot] += Bucket.PerDevice[Slot].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    Snapshot.SnapshotTimeUtc = FromUnixSeconds(NowSeconds);
+    Snapshot.WindowStartUtc = FromUnixSeconds(Window * (double)WindowSeconds);
+    Snapshot.SlidingWindowSeconds = SlidingSeconds;
+    Snapshot.SlidingScansPerSecond = Snapshot.SlidingWindowScans / (float)SlidingSeconds;
+    Snapshot.WindowSeconds = WindowSeconds;
+
+    {
+        FScopeLock ScopeLock(&DeviceNamesLock);
+        for (int32 Slot = 0; Slot <= MaxDevices; ++Slot)
+        {
+            const bool bOther = Slot == MaxDevices;
+            if ((bOther || DeviceHashes[Slot].load(std::memory_order_acquire) != 0) && (DeviceCurrent[Slot] > 0 || DevicePrevious[Slot] > 0))
+            {
+                FScanAnalyticsDeviceRate& Rate = Snapshot.Devices.AddDefaulted_GetRef();
+                Rate.DeviceId = bOther ? TEXT("Other") : DeviceNames[Slot];
+                Rate.ScansCurrentWindow = DeviceCurrent[Slot];
+                Rate.ScansPreviousWindow = DevicePrevious[Slot];
+            }
+        }
+    }
+
+    {
+        // Если в новом окне сканирований ещё не было, sketch хранит предыдущее окно
+        FScopeLock ScopeLock(&HeavyLock);
+        const int64 CurrentSketchWindow = SketchWindow.load(std::memory_order_acquire);
+        const float Elapsed = (float)FMath::Max(NowSeconds - Window * (double)WindowSeconds, 1.0);
+        if (CurrentSketchWindow == Window)
+        {
+            FillItems(HeavyHitters, Elapsed, Snapshot.TopItems);
+            FillItems(PreviousHeavyHitters, WindowSeconds, Snapshot.PreviousTopItems);
+        }
+        else if (CurrentSketchWindow == Window - 1)
+        {
+            FillItems(HeavyHitters, WindowSeconds, Snapshot.PreviousTopItems);
+        }
+    }
+
+    return Snapshot;
+}
+
+int32 FScanAnalytics::FindDeviceSlot(const FString& DeviceId)
+{
+    const uint64 Hash = HashString(DeviceId);
+    const int32 Start = (int32)(Hash % MaxDevices);
+    for (int32 Probe = 0; Probe < MaxDevices; ++Probe)
+    {
+        const int32 Slot = (Start + Probe) % MaxDevices;
+        uint64 Existing = DeviceHashes[Slot].load(std::memory_order_acquire);
+        if (Existing == 0 && DeviceHashes[Slot].compare_exchange_strong(Existing, Hash, std::memory_order_acq_rel))
+        {
+            FScopeLock ScopeLock(&DeviceNamesLock);
+            DeviceNames[Slot] = DeviceId;
+            return Slot;
+        }
+        if (Existing == Hash)
+        {
+            return Slot;
+        }
+    }
+    return MaxDevices;
+}
+
+uint32 FScanAnalytics::AddToSketch(uint64 Hash)
+{
+    // Индексы строк из двух половин одного хеша (Kirsch-Mitzenmacher)
+    const uint32 HashA = (uint32)Hash;
+    const uint32 HashB = (uint32)(Hash >> 32) | 1;
+    uint32 Estimate = MAX_uint32;
+    for (int32 Row = 0; Row < SketchDepth; ++Row)
+    {
+        const uint32 Column = (HashA + Row * HashB) & (SketchWidth - 1);
+        const uint32 Count = Sketch[Row * SketchWidth + Column].fetch_add(1, std::memory_order_relaxed) + 1;
+        Estimate = FMath::Min(Estimate, Count);
+    }
+    return Estimate;
+}
+
+uint32 FScanAnalytics::QuerySketch(uint64 Hash) const
+{
+    const uint32 HashA = (uint32)Hash;
+    const uint32 HashB = (uint32)(Hash >> 32) | 1;
+    uint32 Estimate = MAX_uint32;
+    for (int32 Row = 0; Row < SketchDepth; ++Row)
+    {
+        const uint32 Column = (HashA + Row * HashB) & (SketchWidth - 1);
+        Estimate = FMath::Min(Estimate, Sketch[Row * SketchWidth + Column].load(std::memory_order_relaxed));
+    }
+    return Estimate;
+}
+
+void FScanAnalytics::RollSketch(int64 Window)
+{
+    FScopeLock ScopeLock(&HeavyLock);
+
+    const int64 Current = SketchWindow.load(std::memory_order_acquire);
+    if (Window <= Current)
+    {
+        return;
+    }
+
+    // Завершённое окно сохраняется, только если оно непосредственно предшествует новому
+    Swap(PreviousHeavyHitters, HeavyHitters);
+    if (Current != Window - 1)
+    {
+        PreviousHeavyHitters.Reset();
+    }
+    HeavyHitters.Reset();
+
+    for (std::atomic<uint32>& Counter : Sketch)
+    {
+        Counter.store(0, std::memory_order_relaxed);
+    }
+    HeavyThreshold.store(0, std::memory_order_relaxed);
+    SketchWindow.store(Window, std::memory_order_release);
+}
+
+void FScanAnalytics::UpdateHeavyHitters(const FString& Code, uint64 Hash, uint32 Estimate)
+{
+    FScopeLock ScopeLock(&HeavyLock);
+
+    int32 MinIndex = INDEX_NONE;
+    int32 FoundIndex = INDEX_NONE;
+    for (int32 Index = 0; Index < HeavyHitters.Num(); ++Index)
+    {
+        if (HeavyHitters[Index].Hash == Hash && HeavyHitters[Index].Code == Code)
+        {
+            FoundIndex = Index;
+            break;
+        }
+        if (MinIndex == INDEX_NONE || HeavyHitters[Index].Count < HeavyHitters[MinIndex].Count)
+        {
+            MinIndex = Index;
+        }
+    }
+
+    if (FoundIndex != INDEX_NONE)
+    {
+        HeavyHitters[FoundIndex].Count = FMath::Max(HeavyHitters[FoundIndex].Count, Estimate);
+    }
+    else if (HeavyHitters.Num() < TopK)
+    {
+        HeavyHitters.Add({ Hash, Code, Estimate });
+    }
+    else if (Estimate > HeavyHitters[MinIndex].Count)
+    {
+        HeavyHitters[MinIndex] = { Hash, Code, Estimate };
+    }
+
+    uint32 Threshold = 0;
+    if (HeavyHitters.Num() == TopK)
+    {
+        Threshold = MAX_uint32;
+        for (const FHeavyHitter& Hitter : HeavyHitters)
+        {
+            Threshold = FMath::Min(Threshold, Hitter.Count);
+        }
+    }
+    HeavyThreshold.store(Threshold, std::memory_order_relaxed);
+}
+
+int64 FScanAnalytics::GetWindowIndex(double TimeSeconds) const
+{
+    return FMath::FloorToInt64(TimeSeconds / WindowSeconds);
+}
+
+void FScanAnalytics::FillItems(const TArray<FHeavyHitter>& Source, float ElapsedSeconds, TArray<FScanAnalyticsItem>& OutItems) const
+{
+    OutItems.Reserve(Source.Num());
+    for (const FHeavyHitter& Hitter : Source)
+    {
+        FScanAnalyticsItem& Item = OutItems.AddDefaulted_GetRef();
+        Item.Code = Hitter.Code;
+        Item.EstimatedCount = Hitter.Count;
+        Item.ScansPerSecond = Hitter.Count / ElapsedSeconds;
+    }
+    OutItems.Sort([](const FScanAnalyticsItem& A, const FScanAnalyticsItem& B) { return A.EstimatedCount > B.EstimatedCount; });
+}
+
+FScanAnalyticsFileWriter::FScanAnalyticsFileWriter(const FString& InFilePath)
+    : FilePath(InFilePath)
+{
+}
+
+void FScanAnalyticsFileWriter::Append(const FString& Line)
+{
+    {
+        FScopeLock ScopeLock(&PendingLock);
+        PendingText += Line;
+        PendingText += LINE_TERMINATOR;
+    }
+
+    // Каждая задача забирает всё накопленное; лишние задачи находят пустой буфер
+    Async(EAsyncExecution::ThreadPool, [Self = AsShared()]()
+    {
+        Self->Flush();
+    });
+}
+
+void FScanAnalyticsFileWriter::Flush()
+{
+    FScopeLock WriteScope(&WriteLock);
+
+    FString Text;
+    {
+        FScopeLock ScopeLock(&PendingLock);
+        Text = MoveTemp(PendingText);
+        PendingText.Reset();
+    }
+
+    if (!Text.IsEmpty())
+    {
+        FFileHelper::SaveStringToFile(Text, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+            &IFileManager::Get(), FILEWRITE_Append);
+    }
+}
+
+namespace
+{
+    // Стоимость Ingest на синтетическом потоке: BarcodeScanner.Analytics.Benchmark [Scans] [Threads] [DistinctCodes]
+    void RunAnalyticsBenchmark(const TArray<FString>& Args)
+    {
+        const int32 NumScans = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 500000;
+        const int32 NumThreads = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 64) : 4;
+        const int32 NumCodes = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 10000;
+        constexpr double TargetScansPerSecond = 50000.0;
+
+        // Коды и устройства готовятся заранее, чтобы мерить только агрегатор
+        TArray<FString> Codes;
+        Codes.Reserve(NumCodes);
+        for (int32 Index = 0; Index < NumCodes; ++Index)
+        {
+            Codes.Add(FString::Printf(TEXT("4600000%06d"), Index));
+        }
+        const FString Devices[] = { TEXT("Dock-1"), TEXT("Dock-2"), TEXT("Handheld-1"), TEXT("Handheld-2") };
+
+        // Перекос к началу списка, как у реальных популярных товаров
+        FRandomStream Random(12345);
+        TArray<int32> CodeIndices;
+        CodeIndices.SetNumUninitialized(NumScans);
+        for (int32& CodeIndex : CodeIndices)
+        {
+            CodeIndex = FMath::Min(FMath::FloorToInt(NumCodes * FMath::Pow(Random.GetFraction(), 3.0f)), NumCodes - 1);
+        }
+
+        TUniquePtr<FScanAnalytics> Analytics = MakeUnique<FScanAnalytics>();
+        const double StartTime = FPlatformTime::Seconds();
+        ParallelFor(NumThreads, [&](int32 ThreadIndex)
+        {
+            for (int32 Index = ThreadIndex; Index < NumScans; Index += NumThreads)
+            {
+                // Время событий соответствует целевому темпу, чтобы окна сменялись как в работе
+                Analytics->Ingest(Codes[CodeIndices[Index]], Devices[Index & 3], Index / TargetScansPerSecond);
+            }
+        });
+        const double Elapsed = FMath::Max(FPlatformTime::Seconds() - StartTime, 1e-9);
+
+        const double NanosecondsPerScan = Elapsed * 1e9 / NumScans;
+        const double Throughput = NumScans / Elapsed;
+        UE_LOG(LogTemp, Log, TEXT("[ScanAnalytics] %d scans, %d threads: %.1f ns/scan, %.0f scans/s (%.2f%% of one core at %.0f scans/s)"),
+            NumScans, NumThreads, NanosecondsPerScan, Throughput,
+            NanosecondsPerScan * TargetScansPerSecond / 1e7 * NumThreads, TargetScansPerSecond);
+
+        const FScanAnalyticsSnapshot Snapshot = Analytics->GetSnapshot(NumScans / TargetScansPerSecond, 10.0f);
+        for (int32 Index = 0; Index < FMath::Min(Snapshot.TopItems.Num(), 3); ++Index)
+        {
+            UE_LOG(LogTemp, Log, TEXT("[ScanAnalytics]   top %d: %s ~%lld"), Index + 1, *Snapshot.TopItems[Index].Code, Snapshot.TopItems[Index].EstimatedCount);
+        }
+    }
+
+    FAutoConsoleCommand GScanAnalyticsBenchmarkCommand(
+        TEXT("BarcodeScanner.Analytics.Benchmark"),
+        TEXT("Measures scan analytics ingest cost. Args: [Scans=500000] [Threads=4] [DistinctCodes=10000]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunAnalyticsBenchmark));
+}
@@ -0,0 +1,65 @@
+#include "ScanHistoryListWidget.h"
+#include "SScanHistoryList.h"
+#include "BarcodeScanner.h"
+
+TSharedRef<SWidget> UScanHistoryListWidget::RebuildWidget()
+{
+    HistoryList = SNew(SScanHistoryList)
+        .Capacity(Capacity);
+
+    // Подписка снимается вместе со Slate-ресурсами и восстанавливается для нового списка
+    BindToScanner(BoundScanner.Get());
+    return HistoryList.ToSharedRef();
+}
+
+void UScanHistoryListWidget::ReleaseSlateResources(bool bReleaseChildren)
+{
+    Super::ReleaseSlateResources(bReleaseChildren);
+
+    // Сканер запоминаем, чтобы RebuildWidget подписал пересозданный список
+    if (ABarcodeScanner* Scanner = BoundScanner.Get())
+    {
+        Scanner->OnBarcodeScannedNative.Remove(ScanHandle);
+    }
+    ScanHandle.Reset();
+    HistoryList.Reset();
+}
+
+void UScanHistoryListWidget::AddScan(const FString& Code)
+{
+    if (HistoryList.IsValid())
+    {
+        HistoryList->AddScan(Code);
+    }
+}
+
+void UScanHistoryListWidget::ClearHistory()
+{
+    if (HistoryList.IsValid())
+    {
+        HistoryList->ClearHistory();
+    }
+}
+
+void UScanHistoryListWidget::BindToScanner(ABarcodeScanner* Scanner)
+{
+    if (ABarcodeScanner* PreviousScanner = BoundScanner.Get())
+    {
+        PreviousScanner->OnBarcodeScannedNative.Remove(ScanHandle);
+    }
+
+    BoundScanner = Scanner;
+    if (Scanner)
+    {
+        ScanHandle = Scanner->OnBarcodeScannedNative.AddUObject(this, &UScanHistoryListWidget::HandleScan);
+    }
+}
+
+void UScanHistoryListWidget::HandleScan(const FBarcodeScanRecord& Record)
+{
+    // Время берём из записи, чтобы история совпадала с остальными получателями; запись хранит UTC, список показывает местное
+    if (HistoryList.IsValid())
+    {
+        HistoryList->AddScan(Record.Code, Record.Timestamp + (FDateTime::Now() - FDateTime::UtcNow()));
+    }
+}
@@ -0,0 +1,180 @@
+#include "ScanIngestQueue.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+FScanIngestQueue::FScanIngestQueue()
+{
+    Ring.SetNum(256);
+    // Ручной сброс: Trigger будит всех ждущих читателей, а не одного
+    SpaceAvailable = FPlatformProcess::GetSynchEventFromPool(true);
+}
+
+FScanIngestQueue::~FScanIngestQueue()
+{
+    FPlatformProcess::ReturnSynchEventToPool(SpaceAvailable);
+    SpaceAvailable = nullptr;
+}
+
+void FScanIngestQueue::Configure(int32 Capacity, EScanOverloadPolicy InPolicy, float InBlockTimeoutSeconds)
+{
+    FScopeLock ScopeLock(&Lock);
+    Ring.Reset();
+    Ring.SetNum(FMath::Max(Capacity, 1));
+    Head = 0;
+    Num = 0;
+    Policy = InPolicy;
+    BlockTimeoutSeconds = FMath::Max(InBlockTimeoutSeconds, 0.0f);
+    bShutdown = false;
+}
+
+bool FScanIngestQueue::Enqueue(const FBarcodeScanRecord& Record)
+{
+    double Deadline = 0.0;
+    bool bWaited = false;
+
+    for (;;)
+    {
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (bShutdown)
+            {
+                ++Dropped;
+                return false;
+            }
+
+            // Таймаут читается под блокировкой: Configure может менять его с игрового потока
+            if (!bWaited)
+            {
+                Deadline = FPlatformTime::Seconds() + BlockTimeoutSeconds;
+            }
+
+            const int32 Capacity = Ring.Num();
+            if (Num == Capacity && Policy == EScanOverloadPolicy::DropOldest)
+            {
+                // Вытесняем самое старое сканирование
+                Head = (Head + 1) % Capacity;
+                --Num;
+                ++Dropped;
+            }
+
+            if (Num < Capacity)
+            {
+                FItem& Item = Ring[(Head + Num) % Capacity];
+                Item.Record = Record;
+                Item.bDelayed = bWaited;
+                ++Num;
+                ++Accepted;
+                Delayed += bWaited ? 1 : 0;
+                PeakDepth = FMath::Max(PeakDepth, Num);
+                PeakDepthSinceCheck = FMath::Max(PeakDepthSinceCheck, Num);
+                return true;
+            }
+
+            // Блокировать игровой поток нельзя: он сам разбирает очередь
+            const bool bCanBlock = Policy == EScanOverloadPolicy::BlockReader
+                && !IsInGameThread()
+                && FPlatformTime::Seconds() < Deadline;
+            if (!bCanBlock)
+            {
+                ++Dropped;
+                return false;
+            }
+
+            // Сброс под блокировкой: освобождение места и Trigger после него не потеряются
+            SpaceAvailable->Reset();
+        }
+
+        bWaited = true;
+        const double Remaining = Deadline - FPlatformTime::Seconds();
+        SpaceAvailable->Wait(FTimespan::FromSeconds(FMath::Max(Remaining, 0.0)));
+    }
+}
+
+bool FScanIngestQueue::PeekFront(FBarcodeScanRecord& OutRecord) const
+{
+    FScopeLock ScopeLock(&Lock);
+    if (Num == 0)
+    {
+        return false;
+    }
+    OutRecord = Ring[Head].Record;
+    return true;
+}
+
+bool FScanIngestQueue::PopFront(int64 ExpectedSequenceNumber)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (Num == 0 || Ring[Head].Record.SequenceNumber != ExpectedSequenceNumber)
+        {
+            return false;
+        }
+        Head = (Head + 1) % Ring.Num();
+        --Num;
+    }
+    SpaceAvailable->Trigger();
+    return true;
+}
+
+bool FScanIngestQueue::TryConsumeFront(TFunctionRef<bool(const FBarcodeScanRecord&)> Consumer)
+{
+    {
+        // Передача и извлечение под одной блокировкой: DropOldest не вытеснит уже переданное сканирование
+        FScopeLock ScopeLock(&Lock);
+        if (Num == 0 || !Consumer(Ring[Head].Record))
+        {
+            return false;
+        }
+        Head = (Head + 1) % Ring.Num();
+        --Num;
+    }
+    SpaceAvailable->Trigger();
+    return true;
+}
+
+void FScanIngestQueue::MarkRemainingDelayed()
+{
+    FScopeLock ScopeLock(&Lock);
+    for (int32 Offset = 0; Offset < Num; ++Offset)
+    {
+        FItem& Item = Ring[(Head + Offset) % Ring.Num()];
+        if (!Item.bDelayed)
+        {
+            Item.bDelayed = true;
+            ++Delayed;
+        }
+    }
+}
+
+int32 FScanIngestQueue::ConsumePeakDepth()
+{
+    FScopeLock ScopeLock(&Lock);
+    const int32 Result = PeakDepthSinceCheck;
+    PeakDepthSinceCheck = Num;
+    return Result;
+}
+
+void FScanIngestQueue::Shutdown()
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        bShutdown = true;
+    }
+    SpaceAvailable->Trigger();
+}
+
+FScanIngestStats FScanIngestQueue::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+
+    FScanIngestStats Stats;
+    Stats.QueueDepth = Num;
+    Stats.PeakQueueDepth = PeakDepth;
+    Stats.QueueCapacity = Ring.Num();
+    Stats.Accepted = Accepted;
+    Stats.Dropped = Dropped;
+    Stats.Delayed = Delayed;
+    return Stats;
+}
@@ -0,0 +1,292 @@
+#include "ScanPipeline.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_STATS_GROUP(TEXT("ScanPipeline"), STATGROUP_ScanPipeline, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Stage Process"), STAT_ScanPipeline_StageProcess, STATGROUP_ScanPipeline);
+DECLARE_CYCLE_STAT(TEXT("Dispatch Completed"), STAT_ScanPipeline_Dispatch, STATGROUP_ScanPipeline);
+
+struct FScanPipeline::FStage
+{
+    FName Name;
+    EScanStageAffinity Affinity = EScanStageAffinity::AnyThread;
+    FScanStageFunction Function;
+    int32 MaxWorkers = 1;
+
+    // Кольцевая очередь фиксированного размера; всё ниже защищено Lock
+    mutable FCriticalSection Lock;
+    TArray<FPendingScan> Slots;
+    int32 Head = 0;
+    int32 Num = 0;
+    int32 Reserved = 0;
+    int32 ActiveWorkers = 0;
+
+    int32 PeakDepth = 0;
+    int64 Processed = 0;
+    int64 Rejected = 0;
+    double TotalLatency = 0.0;
+    double MaxLatency = 0.0;
+
+    int32 Capacity() const { return Slots.Num(); }
+};
+
+FScanPipeline::~FScanPipeline()
+{
+}
+
+void FScanPipeline::AddStage(FName StageName, EScanStageAffinity Affinity, FScanStageFunction Function, int32 QueueCapacity, int32 MaxWorkers)
+{
+    check(IsInGameThread());
+
+    TUniquePtr<FStage> Stage = MakeUnique<FStage>();
+    Stage->Name = StageName;
+    Stage->Affinity = Affinity;
+    Stage->Function = MoveTemp(Function);
+    // На игровом потоке параллелизма нет
+    Stage->MaxWorkers = Affinity == EScanStageAffinity::GameThread ? 1 : FMath::Max(MaxWorkers, 1);
+    Stage->Slots.SetNum(FMath::Max(QueueCapacity, 1));
+    Stages.Add(MoveTemp(Stage));
+}
+
+bool FScanPipeline::Submit(const FBarcodeScanRecord& Record)
+{
+    check(IsInGameThread());
+
+    if (bShutdown || Stages.Num() == 0 || !TryReserve(0))
+    {
+        return false;
+    }
+
+    FPendingScan Scan;
+    Scan.PipelineIndex = NextSubmitIndex++;
+    Scan.Record = Record;
+    Push(0, MoveTemp(Scan));
+    return true;
+}
+
+void FScanPipeline::Shutdown()
+{
+    bShutdown = true;
+    OnScanCompleted.Unbind();
+}
+
+bool FScanPipeline::TryReserve(int32 StageIndex)
+{
+    FStage& Stage = *Stages[StageIndex];
+    FScopeLock Lock(&Stage.Lock);
+    if (Stage.Num + Stage.Reserved >= Stage.Capacity())
+    {
+        return false;
+    }
+    ++Stage.Reserved;
+    return true;
+}
+
+bool FScanPipeline::HasRoom(int32 StageIndex) const
+{
+    const FStage& Stage = *Stages[StageIndex];
+    FScopeLock Lock(&Stage.Lock);
+    return Stage.Num + Stage.Reserved < Stage.Capacity();
+}
+
+void FScanPipeline::ReleaseReservation(int32 StageIndex)
+{
+    FStage& Stage = *Stages[StageIndex];
+    FScopeLock Lock(&Stage.Lock);
+    --Stage.Reserved;
+}
+
+void FScanPipeline::Push(int32 StageIndex, FPendingScan&& Scan)
+{
+    FStage& Stage = *Stages[StageIndex];
+    {
+        FScopeLock Lock(&Stage.Lock);
+        --Stage.Reserved;
+        Scan.EnqueueTime = FPlatformTime::Seconds();
+        Stage.Slots[(Stage.Head + Stage.Num) % Stage.Capacity()] = MoveTemp(Scan);
+        ++Stage.Num;
+        Stage.PeakDepth = FMath::Max(Stage.PeakDepth, Stage.Num);
+    }
+    KickStage(StageIndex);
+}
+
+void FScanPipeline::KickStage(int32 StageIndex)
+{
+    if (bShutdown)
+    {
+        return;
+    }
+
+    FStage& Stage = *Stages[StageIndex];
+    {
+        FScopeLock Lock(&Stage.Lock);
+        if (Stage.Num == 0 || Stage.ActiveWorkers >= Stage.MaxWorkers)
+        {
+            return;
+        }
+        ++Stage.ActiveWorkers;
+    }
+
+    const ENamedThreads::Type Thread = Stage.Affinity == EScanStageAffinity::GameThread
+        ? ENamedThreads::GameThread
+        : ENamedThreads::AnyBackgroundThreadNormalTask;
+
+    AsyncTask(Thread, [Self = AsShared(), StageIndex]()
+    {
+        Self->RunStage(StageIndex);
+    });
+}
+
+void FScanPipeline::RunStage(int32 StageIndex)
+{
+    FStage& Stage = *Stages[StageIndex];
+    const bool bLastStage = StageIndex == Stages.Num() - 1;
+
+    while (!bShutdown)
+    {
+        // Место в следующей очереди резервируется до извлечения: так давление передаётся назад
+        if (!bLastStage && !TryReserve(StageIndex + 1))
+        {
+            break;
+        }
+
+        FPendingScan Scan;
+        {
+            FScopeLock Lock(&Stage.Lock);
+            if (Stage.Num == 0)
+            {
+                --Stage.ActiveWorkers;
+                if (!bLastStage)
+                {
+                    // Резерв следующей стадии защищён своим замком, держать этот не нужно
+                    Lock.Unlock();
+                    ReleaseReservation(StageIndex + 1);
+                }
+                return;
+            }
+            Scan = MoveTemp(Stage.Slots[Stage.Head]);
+            Stage.Head = (Stage.Head + 1) % Stage.Capacity();
+            --Stage.Num;
+        }
+
+        // Освободилось место: предыдущая стадия могла остановиться из-за переполнения
+        if (StageIndex > 0)
+        {
+            KickStage(StageIndex - 1);
+        }
+
+        bool bAccepted;
+        {
+            SCOPE_CYCLE_COUNTER(STAT_ScanPipeline_StageProcess);
+            bAccepted = Stage.Function(Scan.Record);
+        }
+
+        const double Latency = FPlatformTime::Seconds() - Scan.EnqueueTime;
+        {
+            FScopeLock Lock(&Stage.Lock);
+            ++Stage.Processed;
+            Stage.Rejected += bAccepted ? 0 : 1;
+            Stage.TotalLatency += Latency;
+            Stage.MaxLatency = FMath::Max(Stage.MaxLatency, Latency);
+        }
+
+        if (!bAccepted)
+        {
+            if (!bLastStage)
+            {
+                ReleaseReservation(StageIndex + 1);
+            }
+            Complete(Scan.PipelineIndex, TOptional<FBarcodeScanRecord>());
+        }
+        else if (bLastStage)
+        {
+            Complete(Scan.PipelineIndex, TOptional<FBarcodeScanRecord>(MoveTemp(Scan.Record)));
+        }
+        else
+        {
+            Push(StageIndex + 1, MoveTemp(Scan));
+        }
+    }
+
+    {
+        FScopeLock Lock(&Stage.Lock);
+        --Stage.ActiveWorkers;
+    }
+
+    // Следующая стадия могла освободиться между неудачным резервом и выходом
+    if (!bLastStage && HasRoom(StageIndex + 1))
+    {
+        KickStage(StageIndex);
+    }
+}
+
+void FScanPipeline::Complete(int64 PipelineIndex, TOptional<FBarcodeScanRecord>&& Result)
+{
+    {
+        FScopeLock Lock(&ReorderLock);
+        Completed.Add(PipelineIndex, MoveTemp(Result));
+    }
+
+    if (!bDispatchScheduled.exchange(true))
+    {
+        AsyncTask(ENamedThreads::GameThread, [Self = AsShared()]()
+        {
+            Self->DispatchCompleted();
+        });
+    }
+}
+
+void FScanPipeline::DispatchCompleted()
+{
+    SCOPE_CYCLE_COUNTER(STAT_ScanPipeline_Dispatch);
+
+    bDispatchScheduled = false;
+
+    // Выдаём только непрерывную последовательность, начиная с NextDispatchIndex
+    TArray<FBarcodeScanRecord> Ready;
+    {
+        FScopeLock Lock(&ReorderLock);
+        while (TOptional<FBarcodeScanRecord>* Result = Completed.Find(NextDispatchIndex))
+        {
+            if (Result->IsSet())
+            {
+                Ready.Add(MoveTemp(Result->GetValue()));
+            }
+            Completed.Remove(NextDispatchIndex);
+            ++NextDispatchIndex;
+        }
+    }
+
+    for (const FBarcodeScanRecord& Record : Ready)
+    {
+        if (bShutdown)
+        {
+            return;
+        }
+        OnScanCompleted.ExecuteIfBound(Record);
+    }
+}
+
+TArray<FScanPipelineStageStats> FScanPipeline::GetStats() const
+{
+    TArray<FScanPipelineStageStats> Result;
+    Result.Reserve(Stages.Num());
+
+    for (const TUniquePtr<FStage>& Stage : Stages)
+    {
+        FScopeLock Lock(&Stage->Lock);
+
+        FScanPipelineStageStats& Stats = Result.AddDefaulted_GetRef();
+        Stats.StageName = Stage->Name;
+        Stats.QueueDepth = Stage->Num;
+        Stats.PeakQueueDepth = Stage->PeakDepth;
+        Stats.QueueCapacity = Stage->Capacity();
+        Stats.Processed = Stage->Processed;
+        Stats.Rejected = Stage->Rejected;
+        Stats.AverageLatencyMs = Stage->Processed > 0 ? (float)(Stage->TotalLatency / Stage->Processed * 1000.0) : 0.0f;
+        Stats.MaxLatencyMs = (float)(Stage->MaxLatency * 1000.0);
+    }
+
+    return Result;
+}
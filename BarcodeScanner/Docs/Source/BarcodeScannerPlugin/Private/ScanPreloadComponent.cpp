@@ -0,0 +1,414 @@
+#include "ScanPreloadComponent.h"
+#include "BarcodeScanner.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/PlatformTime.h"
+
+UScanPreloadComponent::UScanPreloadComponent()
+{
+    // Вся работа идёт из обработчиков сканирований и загрузок
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UScanPreloadComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    GroupMembers.Reset();
+    for (const TPair<FString, FScanPreloadItem>& Pair : ItemAssets)
+    {
+        if (!Pair.Value.GroupId.IsNone())
+        {
+            GroupMembers.FindOrAdd(Pair.Value.GroupId).Add(Pair.Key);
+        }
+    }
+
+    if (!BoundScanner.IsValid())
+    {
+        BindToScanner(Cast<ABarcodeScanner>(GetOwner()));
+    }
+}
+
+void UScanPreloadComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    BindToScanner(nullptr);
+
+    for (TPair<FString, FCacheEntry>& Pair : Cache)
+    {
+        ReleaseEntry(Pair.Value);
+    }
+    Cache.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UScanPreloadComponent::BindToScanner(ABarcodeScanner* Scanner)
+{
+    if (ABarcodeScanner* PreviousScanner = BoundScanner.Get())
+    {
+        PreviousScanner->OnBarcodePreDispatch.Remove(ScanHandle);
+    }
+
+    BoundScanner = Scanner;
+    if (Scanner)
+    {
+        // До OnBarcodeScanned: загрузка стартует раньше, чем Blueprint начнёт показ товара
+        ScanHandle = Scanner->OnBarcodePreDispatch.AddUObject(this, &UScanPreloadComponent::HandleScan);
+    }
+}
+
+void UScanPreloadComponent::RegisterItem(const FString& Code, const FScanPreloadItem& Item)
+{
+    RemoveFromGroup(Code);
+
+    // Закешированные ассеты старой записи больше не соответствуют коду
+    FCacheEntry Stale;
+    if (Cache.RemoveAndCopyValue(Code, Stale))
+    {
+        ReleaseEntry(Stale);
+    }
+
+    ItemAssets.Add(Code, Item);
+    if (!Item.GroupId.IsNone())
+    {
+        GroupMembers.FindOrAdd(Item.GroupId).Add(Code);
+    }
+}
+
+void UScanPreloadComponent::RequestPreload(const FString& Code)
+{
+    if (FCacheEntry* Entry = Cache.Find(Code))
+    {
+        Entry->LastUse = ++UseCounter;
+        return;
+    }
+
+    StartLoad(Code, false, false);
+    EvictToLimits(Code);
+}
+
+bool UScanPreloadComponent::IsItemReady(const FString& Code) const
+{
+    const FCacheEntry* Entry = Cache.Find(Code);
+    return Entry && Entry->bLoaded;
+}
+
+bool UScanPreloadComponent::GetItemAssets(const FString& Code, TArray<UObject*>& OutAssets) const
+{
+    OutAssets.Reset();
+
+    const FScanPreloadItem* Item = ItemAssets.Find(Code);
+    if (!Item || !IsItemReady(Code))
+    {
+        return false;
+    }
+
+    for (const TSoftObjectPtr<UObject>& Asset : Item->Assets)
+    {
+        if (UObject* Loaded = Asset.Get())
+        {
+            OutAssets.Add(Loaded);
+        }
+    }
+    return true;
+}
+
+FScanPreloadStats UScanPreloadComponent::GetPreloadStats() const
+{
+    FScanPreloadStats Stats;
+    Stats.Hits = Hits;
+    Stats.InFlightHits = InFlightHits;
+    Stats.Misses = Misses;
+    const int64 Lookups = Hits + InFlightHits + Misses;
+    Stats.HitRatio = Lookups > 0 ? (float)Hits / Lookups : 0.0f;
+    Stats.InFlightRatio = Lookups > 0 ? (float)InFlightHits / Lookups : 0.0f;
+    Stats.MissRatio = Lookups > 0 ? (float)Misses / Lookups : 0.0f;
+    Stats.PrefetchHits = PrefetchHits;
+    Stats.PrefetchRequests = PrefetchRequests;
+    Stats.Evictions = Evictions;
+    Stats.AverageLoadMs = CompletedLoads > 0 ? (float)(TotalLoadSeconds / CompletedLoads * 1000.0) : 0.0f;
+    Stats.MaxLoadMs = (float)(MaxLoadSeconds * 1000.0);
+    Stats.AverageScanWaitMs = ScanWaits > 0 ? (float)(TotalScanWaitSeconds / ScanWaits * 1000.0) : 0.0f;
+    Stats.CachedItems = Cache.Num();
+    Stats.PendingLoads = PendingLoads;
+    Stats.CachedMemoryMB = CachedBytes / (1024.0f * 1024.0f);
+    return Stats;
+}
+
+void UScanPreloadComponent::HandleScan(const FBarcodeScanRecord& Record)
+{
+    const FString& Code = Record.Code;
+    bool bReadyNow = false;
+
+    // Коды вне каталога не влияют на счётчики, но остаются в истории
+    if (ItemAssets.Contains(Code))
+    {
+        if (FCacheEntry* Entry = Cache.Find(Code))
+        {
+            Entry->LastUse = ++UseCounter;
+            if (Entry->bLoaded)
+            {
+                ++Hits;
+                PrefetchHits += Entry->bPrefetched ? 1 : 0;
+                bReadyNow = true;
+            }
+            else
+            {
+                ++InFlightHits;
+                if (!Entry->bNotifyWhenLoaded)
+                {
+                    Entry->bNotifyWhenLoaded = true;
+                    Entry->ScanWaitStart = FPlatformTime::Seconds();
+                }
+            }
+            Entry->bPrefetched = false;
+        }
+        else
+        {
+            ++Misses;
+            StartLoad(Code, false, true);
+        }
+    }
+
+    LearnTransition(PreviousScanCode, Code);
+    PreviousScanCode = Code;
+
+    PrefetchRelated(Code);
+    EvictToLimits(Code);
+
+    if (bReadyNow)
+    {
+        OnItemAssetsReady.Broadcast(Code);
+    }
+}
+
+void UScanPreloadComponent::StartLoad(const FString& Code, bool bPrefetch, bool bNotifyWhenLoaded)
+{
+    const FScanPreloadItem* Item = ItemAssets.Find(Code);
+    if (!Item || Cache.Contains(Code))
+    {
+        return;
+    }
+
+    TArray<FSoftObjectPath> Paths;
+    for (const TSoftObjectPtr<UObject>& Asset : Item->Assets)
+    {
+        if (!Asset.IsNull())
+        {
+            Paths.Add(Asset.ToSoftObjectPath());
+        }
+    }
+
+    // Запись создаётся до запроса: уже загруженные ассеты могут завершить его сразу
+    const uint64 RequestId = NextRequestId++;
+    const double Now = FPlatformTime::Seconds();
+    FCacheEntry& Entry = Cache.Add(Code);
+    Entry.RequestId = RequestId;
+    Entry.LastUse = ++UseCounter;
+    Entry.RequestTime = Now;
+    Entry.ScanWaitStart = Now;
+    Entry.bPrefetched = bPrefetch;
+    Entry.bNotifyWhenLoaded = bNotifyWhenLoaded;
+    ++PendingLoads;
+
+    if (Paths.Num() == 0)
+    {
+        HandleLoadCompleted(Code, RequestId);
+        return;
+    }
+
+    // Отсканированный товар важнее предсказанных
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths),
+        FStreamableDelegate::CreateUObject(this, &UScanPreloadComponent::HandleLoadCompleted, Code, RequestId),
+        bPrefetch ? FStreamableManager::DefaultAsyncLoadPriority : FStreamableManager::AsyncLoadHighPriority);
+
+    FCacheEntry* Added = Cache.Find(Code);
+    if (Added && Added->RequestId == RequestId)
+    {
+        Added->Handle = Handle;
+    }
+    else if (Handle.IsValid())
+    {
+        // Запись вытеснена, пока обрабатывалось мгновенное завершение
+        Handle->ReleaseHandle();
+    }
+}
+
+void UScanPreloadComponent::ReleaseEntry(FCacheEntry& Entry)
+{
+    if (Entry.Handle.IsValid())
+    {
+        if (Entry.Handle->HasLoadCompleted())
+        {
+            Entry.Handle->ReleaseHandle();
+        }
+        else
+        {
+            Entry.Handle->CancelHandle();
+        }
+        Entry.Handle.Reset();
+    }
+
+    if (Entry.bLoaded)
+    {
+        CachedBytes -= Entry.SizeBytes;
+    }
+    else
+    {
+        --PendingLoads;
+    }
+}
+
+void UScanPreloadComponent::HandleLoadCompleted(FString Code, uint64 RequestId)
+{
+    FCacheEntry* Entry = Cache.Find(Code);
+    if (!Entry || Entry->RequestId != RequestId || Entry->bLoaded)
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    const double LoadSeconds = Now - Entry->RequestTime;
+    ++CompletedLoads;
+    TotalLoadSeconds += LoadSeconds;
+    MaxLoadSeconds = FMath::Max(MaxLoadSeconds, LoadSeconds);
+
+    int64 SizeBytes = 0;
+    if (const FScanPreloadItem* Item = ItemAssets.Find(Code))
+    {
+        for (const TSoftObjectPtr<UObject>& Asset : Item->Assets)
+        {
+            if (UObject* Loaded = Asset.Get())
+            {
+                SizeBytes += Loaded->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+            }
+        }
+    }
+
+    Entry->bLoaded = true;
+    Entry->SizeBytes = SizeBytes;
+    CachedBytes += SizeBytes;
+    --PendingLoads;
+
+    const bool bNotify = Entry->bNotifyWhenLoaded;
+    if (bNotify)
+    {
+        ++ScanWaits;
+        TotalScanWaitSeconds += Now - Entry->ScanWaitStart;
+        Entry->bNotifyWhenLoaded = false;
+    }
+
+    // Размер известен только после загрузки, поэтому лимит памяти проверяется здесь
+    EvictToLimits(Code);
+
+    if (bNotify)
+    {
+        OnItemAssetsReady.Broadcast(Code);
+    }
+}
+
+void UScanPreloadComponent::PrefetchRelated(const FString& Code)
+{
+    int32 Budget = MaxPrefetchPerScan;
+    auto TryPrefetch = [this, &Code, &Budget](const FString& Candidate)
+    {
+        if (Budget > 0 && Candidate != Code && !Cache.Contains(Candidate) && ItemAssets.Contains(Candidate))
+        {
+            StartLoad(Candidate, true, false);
+            ++PrefetchRequests;
+            --Budget;
+        }
+    };
+
+    // Сначала товары, которые по истории сканируют следом, затем остальные из той же группы
+    if (const TArray<FSuccessor>* List = Successors.Find(Code))
+    {
+        for (const FSuccessor& Successor : *List)
+        {
+            TryPrefetch(Successor.Code);
+        }
+    }
+
+    const FScanPreloadItem* Item = ItemAssets.Find(Code);
+    const TArray<FString>* Members = Item && !Item->GroupId.IsNone() ? GroupMembers.Find(Item->GroupId) : nullptr;
+    if (Members)
+    {
+        for (int32 Index = 0; Index < Members->Num() && Budget > 0; ++Index)
+        {
+            TryPrefetch((*Members)[Index]);
+        }
+    }
+}
+
+void UScanPreloadComponent::LearnTransition(const FString& FromCode, const FString& ToCode)
+{
+    if (FromCode.IsEmpty() || FromCode == ToCode || !ItemAssets.Contains(FromCode) || !ItemAssets.Contains(ToCode))
+    {
+        return;
+    }
+
+    // Фиксированное число преемников на товар: новый вытесняет самый редкий
+    TArray<FSuccessor>& List = Successors.FindOrAdd(FromCode);
+    FSuccessor* Existing = List.FindByPredicate([&ToCode](const FSuccessor& Successor) { return Successor.Code == ToCode; });
+    if (Existing)
+    {
+        ++Existing->Count;
+    }
+    else if (List.Num() < MaxSuccessorsPerItem)
+    {
+        List.Add({ ToCode, 1 });
+    }
+    else
+    {
+        List.Last() = { ToCode, 1 };
+    }
+
+    List.StableSort([](const FSuccessor& A, const FSuccessor& B) { return A.Count > B.Count; });
+}
+
+void UScanPreloadComponent::EvictToLimits(const FString& ProtectedCode)
+{
+    const int64 MaxBytes = (int64)(MaxCacheMemoryMB * 1024.0f * 1024.0f);
+    while (Cache.Num() > MaxCachedItems || CachedBytes > MaxBytes)
+    {
+        const FString* OldestCode = nullptr;
+        uint64 OldestUse = MAX_uint64;
+        for (const TPair<FString, FCacheEntry>& Pair : Cache)
+        {
+            // Товар, которого ждут после сканирования, не вытесняем: иначе OnItemAssetsReady не придёт
+            if (Pair.Value.bNotifyWhenLoaded)
+            {
+                continue;
+            }
+            if (Pair.Value.LastUse < OldestUse && Pair.Key != ProtectedCode)
+            {
+                OldestUse = Pair.Value.LastUse;
+                OldestCode = &Pair.Key;
+            }
+        }
+
+        if (!OldestCode)
+        {
+            break;
+        }
+
+        FCacheEntry Evicted;
+        Cache.RemoveAndCopyValue(FString(*OldestCode), Evicted);
+        ReleaseEntry(Evicted);
+        ++Evictions;
+    }
+}
+
+void UScanPreloadComponent::RemoveFromGroup(const FString& Code)
+{
+    const FScanPreloadItem* Existing = ItemAssets.Find(Code);
+    if (!Existing || Existing->GroupId.IsNone())
+    {
+        return;
+    }
+
+    if (TArray<FString>* Members = GroupMembers.Find(Existing->GroupId))
+    {
+        Members->Remove(Code);
+    }
+}
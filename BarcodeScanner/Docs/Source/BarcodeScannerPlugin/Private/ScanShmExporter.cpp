@@ -0,0 +1,201 @@
+#include "ScanShmExporter.h"
+#include "ScanShmLayout.h"
+
+#if PLATFORM_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Копирует строку в UTF-8 с обрезкой по границе символа; возвращает длину в байтах
+    uint32 CopyUtf8(const FString& Source, char* Destination, uint32 Capacity)
+    {
+        FTCHARToUTF8 Utf8(*Source);
+        uint32 Length = FMath::Min((uint32)Utf8.Length(), Capacity);
+        if (Length < (uint32)Utf8.Length())
+        {
+            while (Length > 0 && (Utf8.Get()[Length] & 0xC0) == 0x80)
+            {
+                --Length;
+            }
+        }
+        FMemory::Memcpy(Destination, Utf8.Get(), Length);
+        return Length;
+    }
+
+#if PLATFORM_LINUX
+    enum class ESegmentOwner
+    {
+        Gone,       // Сегмент удалён между попытками
+        InUse,      // Живой писатель, либо заголовок ещё не заполнен
+        Abandoned   // Писатель закрыл сегмент или его процесса больше нет
+    };
+
+    // OutWriterPid - владелец для журнала, 0 если заголовок не заполнен
+    ESegmentOwner InspectSegment(const char* Name, int32& OutWriterPid)
+    {
+        OutWriterPid = 0;
+        const int Fd = shm_open(Name, O_RDONLY, 0);
+        if (Fd < 0)
+        {
+            return errno == ENOENT ? ESegmentOwner::Gone : ESegmentOwner::InUse;
+        }
+
+        struct stat Stat;
+        void* Mapping = MAP_FAILED;
+        if (fstat(Fd, &Stat) == 0 && Stat.st_size >= (off_t)sizeof(ScanShm::FHeader))
+        {
+            Mapping = mmap(nullptr, sizeof(ScanShm::FHeader), PROT_READ, MAP_SHARED, Fd, 0);
+        }
+        close(Fd);
+
+        // Короткий сегмент или без сигнатуры выглядит так же, как сегмент писателя между shm_open
+        // и заполнением заголовка, поэтому считается занятым; чужие сегменты тоже не удаляем
+        if (Mapping == MAP_FAILED)
+        {
+            return ESegmentOwner::InUse;
+        }
+
+        const ScanShm::FHeader* Existing = static_cast<const ScanShm::FHeader*>(Mapping);
+        const bool bInitialized = Existing->Magic == ScanShm::Magic;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const bool bClosed = Existing->WriterState.load(std::memory_order_acquire) == (uint32)ScanShm::EWriterState::Closed;
+        OutWriterPid = bInitialized ? Existing->WriterPid : 0;
+        munmap(Mapping, sizeof(ScanShm::FHeader));
+
+        if (!bInitialized || OutWriterPid <= 0)
+        {
+            return ESegmentOwner::InUse;
+        }
+
+        // EPERM - процесс жив, но принадлежит другому пользователю
+        const bool bWriterDead = kill(OutWriterPid, 0) != 0 && errno == ESRCH;
+        return bClosed || bWriterDead ? ESegmentOwner::Abandoned : ESegmentOwner::InUse;
+    }
+#endif
+}
+
+FScanShmExporter::~FScanShmExporter()
+{
+    Close();
+}
+
+bool FScanShmExporter::Open(const FString& Name, int32 SlotCount)
+{
+    Close();
+
+#if PLATFORM_LINUX
+    const uint32 RingSize = FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(SlotCount, 2));
+    const SIZE_T SegmentSize = ScanShm::GetSegmentSize(RingSize);
+    const FTCHARToUTF8 NameUtf8(*Name);
+
+    // Сегмент живого писателя не трогаем; пересоздаём только сегмент с заполненным заголовком,
+    // который писатель закрыл или чей процесс завершился
+    int Fd = shm_open(NameUtf8.Get(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (Fd < 0 && errno == EEXIST)
+    {
+        int32 ExistingPid = 0;
+        const ESegmentOwner Owner = InspectSegment(NameUtf8.Get(), ExistingPid);
+        if (Owner == ESegmentOwner::InUse)
+        {
+            if (ExistingPid > 0)
+            {
+                UE_LOG(LogTemp, Error, TEXT("[ScanShm] %s is in use by process %d, choose another SharedMemoryName"), *Name, ExistingPid);
+            }
+            else
+            {
+                UE_LOG(LogTemp, Error, TEXT("[ScanShm] %s exists but has no scan ring header: another writer is starting, or it was left by a writer that crashed during Open (remove /dev/shm%s)"), *Name, *Name);
+            }
+            return false;
+        }
+
+        if (Owner == ESegmentOwner::Abandoned)
+        {
+            UE_LOG(LogTemp, Log, TEXT("[ScanShm] Replacing abandoned segment %s (writer %d)"), *Name, ExistingPid);
+            shm_unlink(NameUtf8.Get());
+        }
+        Fd = shm_open(NameUtf8.Get(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (Fd < 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[ScanShm] shm_open(%s) failed, errno %d"), *Name, errno);
+        return false;
+    }
+
+    void* Mapping = MAP_FAILED;
+    if (ftruncate(Fd, (off_t)SegmentSize) == 0)
+    {
+        Mapping = mmap(nullptr, SegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+    }
+    close(Fd);
+    if (Mapping == MAP_FAILED)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[ScanShm] Failed to map %s (%llu bytes), errno %d"), *Name, (uint64)SegmentSize, errno);
+        shm_unlink(NameUtf8.Get());
+        return false;
+    }
+
+    // Новый сегмент заполнен нулями. Сигнатура пишется после WriterPid: другой экземпляр, увидев её,
+    // проверяет уже настоящего владельца. Состояние Active публикуется последним
+    Header = static_cast<ScanShm::FHeader*>(Mapping);
+    Header->Version = ScanShm::Version;
+    Header->SlotCount = RingSize;
+    Header->SlotSize = sizeof(ScanShm::FSlot);
+    Header->WriterPid = (int32)getpid();
+    Header->WriteSequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Header->Magic = ScanShm::Magic;
+    Header->WriterState.store((uint32)ScanShm::EWriterState::Active, std::memory_order_release);
+
+    Slots = ScanShm::GetSlots(Header);
+    MappedSize = SegmentSize;
+    NextSequence = 1;
+    SegmentName = Name;
+
+    UE_LOG(LogTemp, Log, TEXT("[ScanShm] Exporting scans to %s, %u slots"), *Name, RingSize);
+    return true;
+#else
+    UE_LOG(LogTemp, Warning, TEXT("[ScanShm] Shared memory export is only supported on Linux"));
+    return false;
+#endif
+}
+
+void FScanShmExporter::Close()
+{
+#if PLATFORM_LINUX
+    if (Header)
+    {
+        Header->WriterState.store((uint32)ScanShm::EWriterState::Closed, std::memory_order_release);
+        munmap(Header, MappedSize);
+        shm_unlink(TCHAR_TO_UTF8(*SegmentName));
+
+        UE_LOG(LogTemp, Log, TEXT("[ScanShm] Closed %s after %lld records"), *SegmentName, GetPublishedCount());
+        Header = nullptr;
+        Slots = nullptr;
+        MappedSize = 0;
+    }
+#endif
+}
+
+void FScanShmExporter::Publish(const FBarcodeScanRecord& Record)
+{
+    if (!Header)
+    {
+        return;
+    }
+
+    static const FDateTime UnixEpoch(1970, 1, 1);
+    ScanShm::PublishSlot(Header, Slots, NextSequence++, [&Record](ScanShm::FSlot& Slot)
+    {
+        Slot.ScanSequenceNumber = Record.SequenceNumber;
+        Slot.TimestampUnixNs = (Record.Timestamp - UnixEpoch).GetTicks() * (int64)(1000000000 / ETimespan::TicksPerSecond);
+        Slot.CodeLength = (uint16)CopyUtf8(Record.Code, Slot.Code, ScanShm::MaxCodeBytes);
+        Slot.DeviceIdLength = (uint8)CopyUtf8(Record.DeviceId, Slot.DeviceId, ScanShm::MaxDeviceIdBytes);
+        Slot.SymbologyLength = (uint8)CopyUtf8(Record.Symbology, Slot.Symbology, ScanShm::MaxSymbologyBytes);
+    });
+}
@@ -0,0 +1,218 @@
+#include "ScanTrace.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+    void WriteVarInt(FArchive& Ar, uint64 Value)
+    {
+        do
+        {
+            uint8 Byte = Value & 0x7F;
+            Value >>= 7;
+            if (Value != 0)
+            {
+                Byte |= 0x80;
+            }
+            Ar << Byte;
+        }
+        while (Value != 0);
+    }
+
+    FString Utf8ToString(const uint8* Bytes, int32 Length)
+    {
+        FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes), Length);
+        return FString(Converted.Length(), Converted.Get());
+    }
+}
+
+bool FScanInputAssembler::Feed(const FScanRawEvent& Event, FString& OutData)
+{
+    if (Event.Kind == EScanRawEventKind::HidReport)
+    {
+        OutData = Utf8ToString(Event.Payload.GetData(), Event.Payload.Num());
+        return !OutData.IsEmpty();
+    }
+
+    // Клавиатурный режим: Enter завершает код
+    const bool bTerminator = Event.Payload.Num() == 1 && (Event.Payload[0] == '\r' || Event.Payload[0] == '\n');
+    if (!bTerminator)
+    {
+        PendingKeystrokes.Append(Event.Payload);
+        return false;
+    }
+
+    if (PendingKeystrokes.Num() == 0)
+    {
+        return false;
+    }
+
+    OutData = Utf8ToString(PendingKeystrokes.GetData(), PendingKeystrokes.Num());
+    PendingKeystrokes.Reset();
+    return true;
+}
+
+FScanTraceRecorder::~FScanTraceRecorder()
+{
+    Close();
+}
+
+bool FScanTraceRecorder::Open(const FString& FilePath, const FString& DeviceId)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Writer)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[ScanTrace] Failed to open %s for writing"), *FilePath);
+        return false;
+    }
+
+    uint32 Magic = ScanTrace::Magic;
+    uint16 Version = ScanTrace::Version;
+    uint16 Reserved = 0;
+    int64 StartTicks = FDateTime::UtcNow().GetTicks();
+    *Writer << Magic << Version << Reserved << StartTicks;
+
+    FTCHARToUTF8 DeviceUtf8(*DeviceId);
+    WriteVarInt(*Writer, DeviceUtf8.Length());
+    Writer->Serialize(const_cast<ANSICHAR*>(DeviceUtf8.Get()), DeviceUtf8.Length());
+
+    StartTimeSeconds = FPlatformTime::Seconds();
+    LastEventMicros = 0;
+    EventCount = 0;
+
+    UE_LOG(LogTemp, Log, TEXT("[ScanTrace] Recording to %s"), *FilePath);
+    return true;
+}
+
+void FScanTraceRecorder::Record(const FScanRawEvent& Event)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (!Writer)
+    {
+        return;
+    }
+
+    // Время хранится дельтами в микросекундах от предыдущего события
+    const uint64 EventMicros = (uint64)FMath::Max((Event.TimeSeconds - StartTimeSeconds) * 1000000.0, 0.0);
+    const uint64 DeltaMicros = EventMicros > LastEventMicros ? EventMicros - LastEventMicros : 0;
+    LastEventMicros = FMath::Max(EventMicros, LastEventMicros);
+
+    WriteVarInt(*Writer, DeltaMicros);
+    uint8 Kind = (uint8)Event.Kind;
+    *Writer << Kind;
+    WriteVarInt(*Writer, Event.Payload.Num());
+    Writer->Serialize(const_cast<uint8*>(Event.Payload.GetData()), Event.Payload.Num());
+    ++EventCount;
+}
+
+void FScanTraceRecorder::Close()
+{
+    FScopeLock ScopeLock(&Lock);
+    if (Writer)
+    {
+        Writer->Close();
+        Writer.Reset();
+        UE_LOG(LogTemp, Log, TEXT("[ScanTrace] Recording closed, %lld events"), EventCount);
+    }
+}
+
+bool FScanTraceRecorder::IsRecording() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Writer.IsValid();
+}
+
+bool FScanTraceReader::Load(const FString& FilePath)
+{
+    Data.Reset();
+    Offset = 0;
+    CurrentMicros = 0;
+    DeviceId.Reset();
+
+    if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[ScanTrace] Failed to read %s"), *FilePath);
+        return false;
+    }
+
+    // Сигнатура, версия, резерв и время начала
+    constexpr int32 HeaderSize = sizeof(uint32) + sizeof(uint16) * 2 + sizeof(int64);
+    uint32 Magic = 0;
+    uint16 Version = 0;
+    if (Data.Num() >= HeaderSize)
+    {
+        FMemory::Memcpy(&Magic, Data.GetData(), sizeof(Magic));
+        FMemory::Memcpy(&Version, Data.GetData() + sizeof(Magic), sizeof(Version));
+    }
+    if (Magic != ScanTrace::Magic || Version != ScanTrace::Version)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[ScanTrace] %s is not a scan trace (version %u)"), *FilePath, Version);
+        Data.Reset();
+        return false;
+    }
+    Offset = HeaderSize;
+
+    uint64 DeviceLength = 0;
+    if (!ReadVarInt(DeviceLength) || Offset + (int64)DeviceLength > Data.Num())
+    {
+        Data.Reset();
+        return false;
+    }
+    DeviceId = Utf8ToString(Data.GetData() + Offset, (int32)DeviceLength);
+    Offset += (int32)DeviceLength;
+    return true;
+}
+
+bool FScanTraceReader::Next(FScanRawEvent& OutEvent)
+{
+    uint64 DeltaMicros = 0;
+    uint64 PayloadLength = 0;
+    if (!ReadVarInt(DeltaMicros) || Offset >= Data.Num())
+    {
+        return false;
+    }
+
+    // Неизвестный тип означает повреждённую запись или файл более новой версии
+    const uint8 Kind = Data[Offset++];
+    if (Kind > (uint8)EScanRawEventKind::Keystroke)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[ScanTrace] Unknown event kind %u at offset %d, replay stopped"), Kind, Offset - 1);
+        Offset = Data.Num();
+        return false;
+    }
+    OutEvent.Kind = (EScanRawEventKind)Kind;
+
+    if (!ReadVarInt(PayloadLength) || Offset + (int64)PayloadLength > Data.Num())
+    {
+        UE_LOG(LogTemp, Error, TEXT("[ScanTrace] Truncated event at offset %d, replay stopped"), Offset);
+        Offset = Data.Num();
+        return false;
+    }
+
+    CurrentMicros += DeltaMicros;
+    OutEvent.TimeSeconds = CurrentMicros / 1000000.0;
+    OutEvent.Payload.Reset();
+    OutEvent.Payload.Append(Data.GetData() + Offset, (int32)PayloadLength);
+    Offset += (int32)PayloadLength;
+    return true;
+}
+
+bool FScanTraceReader::ReadVarInt(uint64& OutValue)
+{
+    OutValue = 0;
+    for (int32 Shift = 0; Shift < 64 && Offset < Data.Num(); Shift += 7)
+    {
+        const uint8 Byte = Data[Offset++];
+        OutValue |= (uint64)(Byte & 0x7F) << Shift;
+        if ((Byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
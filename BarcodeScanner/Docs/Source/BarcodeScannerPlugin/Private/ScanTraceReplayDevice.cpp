@@ -0,0 +1,86 @@
+#include "ScanTraceReplayDevice.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+FScanTraceReplayDevice::FScanTraceReplayDevice(const FString& InFilePath, float InSpeedMultiplier)
+    : FilePath(InFilePath)
+    , SpeedMultiplier(FMath::Max(InSpeedMultiplier, 0.0f))
+    , DeviceId(TEXT("Replay"))
+{
+}
+
+FScanTraceReplayDevice::~FScanTraceReplayDevice()
+{
+    Close();
+}
+
+bool FScanTraceReplayDevice::Open(FScanRawEventSink InSink)
+{
+    Close();
+
+    if (!Reader.Load(FilePath))
+    {
+        return false;
+    }
+
+    // Записи сохраняют исходное устройство, чтобы фильтры по DeviceId работали при воспроизведении
+    if (!Reader.GetDeviceId().IsEmpty())
+    {
+        DeviceId = Reader.GetDeviceId();
+    }
+
+    Sink = MoveTemp(InSink);
+    bStopRequested = false;
+    bFinished = false;
+    Thread = FRunnableThread::Create(this, TEXT("ScanTraceReplay"));
+    return Thread != nullptr;
+}
+
+void FScanTraceReplayDevice::Close()
+{
+    if (Thread)
+    {
+        bStopRequested = true;
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+    Sink = nullptr;
+}
+
+uint32 FScanTraceReplayDevice::Run()
+{
+    const double StartTime = FPlatformTime::Seconds();
+    int64 EventCount = 0;
+
+    FScanRawEvent Event;
+    while (!bStopRequested && Reader.Next(Event))
+    {
+        if (SpeedMultiplier > 0.0f)
+        {
+            // Спим короткими интервалами, чтобы Close не ждал длинных пауз записи
+            const double TargetTime = StartTime + Event.TimeSeconds / SpeedMultiplier;
+            for (double Now = FPlatformTime::Seconds(); Now < TargetTime && !bStopRequested; Now = FPlatformTime::Seconds())
+            {
+                FPlatformProcess::Sleep((float)FMath::Min(TargetTime - Now, 0.01));
+            }
+        }
+
+        if (bStopRequested)
+        {
+            break;
+        }
+
+        // Метка времени - момент воспроизведения, чтобы задержки конвейера мерились честно
+        Event.TimeSeconds = FPlatformTime::Seconds();
+        Sink(Event);
+        ++EventCount;
+    }
+
+    const double Elapsed = FPlatformTime::Seconds() - StartTime;
+    UE_LOG(LogTemp, Log, TEXT("[ScanTrace] Replay of %s finished: %lld events in %.3f s"), *FilePath, EventCount, Elapsed);
+
+    bFinished = true;
+    return 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "BarcodeScanTypes.h"
+#include "AwaitBarcodeScanAction.generated.h"
+
+class ABarcodeScanner;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAwaitBarcodeScanResult, const FBarcodeScanRecord&, Record);
+
+// Асинхронный Blueprint-узел: ждёт сканирование, подходящее под фильтр
+UCLASS()
+class BARCODESCANNERPLUGIN_API UAwaitBarcodeScanAction : public UBlueprintAsyncActionBase
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner", meta = (BlueprintInternalUseOnly = "true", DisplayName = "Await Next Scan"))
+    static UAwaitBarcodeScanAction* AwaitNextScan(ABarcodeScanner* Scanner, FBarcodeScanFilter Filter, float TimeoutSeconds = 0.0f);
+
+    // Пришло подходящее сканирование
+    UPROPERTY(BlueprintAssignable)
+    FOnAwaitBarcodeScanResult OnScanned;
+
+    // Истёк таймаут или сканер завершил работу
+    UPROPERTY(BlueprintAssignable)
+    FOnAwaitBarcodeScanResult OnTimeout;
+
+    virtual void Activate() override;
+
+private:
+    void HandleResult(const TOptional<FBarcodeScanRecord>& Result);
+
+    TWeakObjectPtr<ABarcodeScanner> Scanner;
+    FBarcodeScanFilter Filter;
+    float TimeoutSeconds = 0.0f;
+};
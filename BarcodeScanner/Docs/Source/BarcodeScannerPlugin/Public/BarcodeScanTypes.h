@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BarcodeScanTypes.generated.h"
+
+// Одно обработанное сканирование
+USTRUCT(BlueprintType)
+struct BARCODESCANNERPLUGIN_API FBarcodeScanRecord
+{
+    GENERATED_BODY()
+
+    // Код без префикса символики
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner")
+    FString Code;
+
+    // Идентификатор символики AIM (например "]E0" для EAN-13), пусто если сканер его не передаёт
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner")
+    FString Symbology;
+
+    // Устройство, с которого пришло сканирование
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner")
+    FString DeviceId;
+
+    // Порядковый номер сканирования в рамках сканера
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner")
+    int64 SequenceNumber = 0;
+
+    // Время сканирования в UTC; для показа пользователю переводится в местное
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner")
+    FDateTime Timestamp;
+
+    // Время получения по FPlatformTime::Seconds для измерения задержек
+    double ReceiveTimeSeconds = 0.0;
+
+    // Разбирает сырые данные сканера, отделяя префикс символики AIM
+    static FBarcodeScanRecord FromRawData(const FString& Data, const FString& DeviceId, int64 SequenceNumber);
+};
+
+// Фильтр сканирований; пустое поле означает "любое значение"
+USTRUCT(BlueprintType)
+struct BARCODESCANNERPLUGIN_API FBarcodeScanFilter
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Barcode Scanner")
+    FString Symbology;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Barcode Scanner")
+    FString Prefix;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Barcode Scanner")
+    FString DeviceId;
+
+    bool Matches(const FBarcodeScanRecord& Record) const;
+};
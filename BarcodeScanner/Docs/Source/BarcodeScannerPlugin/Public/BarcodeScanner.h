@@ -2,8 +2,19 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Async/Future.h"
+#include "BarcodeScanTypes.h"
+#include "ScanPipeline.h"
+#include "ScanIngestQueue.h"
+#include "ScanTrace.h"
+#include "BarcodeScannerDevice.h"
+#include "ScanAnalytics.h"
+#include "ScanShmExporter.h"
+#include <atomic>
 #include "BarcodeScanner.generated.h"
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBarcodeScannedNative, const FBarcodeScanRecord& /*Record*/);
+
 UCLASS()
 class BARCODESCANNERPLUGIN_API ABarcodeScanner : public AActor
 {
@@ -13,6 +24,8 @@ public:
     ABarcodeScanner();
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void BeginDestroy() override;
     virtual void Tick(float DeltaTime) override;
 
     UFUNCTION(BlueprintCallable, Category = "Barcode Scanner")
@@ -27,10 +40,162 @@ public:
     UFUNCTION(BlueprintImplementableEvent, Category = "Barcode Scanner")
     void OnBarcodeScanned(const FString& Barcode);
 
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner")
+    FBarcodeScanRecord GetLastScanRecord() const { return LastScanRecord; }
+
+    // Нативная подписка на сканирования для C++ и Slate
+    FOnBarcodeScannedNative OnBarcodeScannedNative;
+
+    // Вызывается до OnBarcodeScanned и экспорта: для работы, которую выгодно начать как можно раньше (загрузка ассетов)
+    FOnBarcodeScannedNative OnBarcodePreDispatch;
+
+    /**
+     * Ожидание следующего сканирования, подходящего под фильтр.
+     * Будущее разрешается из обработки сканирования без опроса; пустое значение - истёк
+     * таймаут (TimeoutSeconds <= 0 - без таймаута) или сканер завершил работу.
+     * Вызывать с игрового потока; продолжения .Next() выполняются на нём же.
+     */
+    TFuture<TOptional<FBarcodeScanRecord>> AwaitNextScan(const FBarcodeScanFilter& Filter, float TimeoutSeconds = 0.0f);
+
+    // Конвейер обработки; стадии регистрируются из C++ до StartScanner
+    FScanPipeline& GetScanPipeline() { return *Pipeline; }
+
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner|Pipeline")
+    TArray<FScanPipelineStageStats> GetPipelineStats() const { return Pipeline->GetStats(); }
+
+    // Идентификатор устройства, подставляемый в записи сканирований
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Barcode Scanner")
+    FString DeviceId = TEXT("Default");
+
+    // Ставит сырые данные сканера в очередь приёма; можно вызывать с любого потока
+    bool EnqueueScanData(const FString& Data, const FString& SourceDeviceId);
+
+    // Размер очереди между чтением сканера и выдачей в OnBarcodeScanned
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Ingest", Meta = (ClampMin = "1"))
+    int32 IngestQueueCapacity = 256;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Ingest")
+    EScanOverloadPolicy OverloadPolicy = EScanOverloadPolicy::DropOldest;
+
+    // Максимальное время ожидания потока чтения в режиме BlockReader
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Ingest", Meta = (ClampMin = "0.0"))
+    float BlockReaderTimeoutSeconds = 1.0f;
+
+    // Заполнение очереди (в процентах), при котором вызывается OnScanQueueHighWatermark
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Barcode Scanner|Ingest", Meta = (ClampMin = "1.0", ClampMax = "100.0"))
+    float HighWatermarkPercent = 75.0f;
+
+    // Максимум сканирований, выдаваемых за кадр (0 - без ограничения)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Barcode Scanner|Ingest", Meta = (ClampMin = "0"))
+    int32 MaxDispatchPerTick = 0;
+
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner|Ingest")
+    FScanIngestStats GetIngestStats() const { return IngestQueue.GetStats(); }
+
+    // Очередь приёма заполнилась выше HighWatermarkPercent; повторно - после спада ниже половины порога
+    UFUNCTION(BlueprintImplementableEvent, Category = "Barcode Scanner|Ingest")
+    void OnScanQueueHighWatermark(const FScanIngestStats& Stats);
+
+    // Источник сырых событий; открывается в StartScanner и закрывается в StopScanner
+    void SetDevice(TSharedPtr<IBarcodeScannerDevice> InDevice);
+
+    // Сканер в клавиатурном режиме: при BeginPlay подключается FKeyboardWedgeScannerDevice, если устройство не задано
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Device")
+    bool bUseKeyboardWedge = false;
+
+    // Не передавать перехваченные символы виджетам и игровому вводу
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Device")
+    bool bConsumeKeyboardWedgeInput = false;
+
+    // Сырое событие устройства: запись в трассу, сборка кода и постановка в очередь; с любого потока
+    void HandleRawInput(const FScanRawEvent& Event, const FString& SourceDeviceId);
+
+    // Запись сырого потока событий в файл для последующего воспроизведения
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner|Trace")
+    bool StartTraceRecording(const FString& FilePath);
+
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner|Trace")
+    void StopTraceRecording();
+
+    // Воспроизведение записи вместо физического устройства: 1 - исходный темп, N - быстрее, 0 - максимум
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner|Trace")
+    bool StartTraceReplay(const FString& FilePath, float SpeedMultiplier = 1.0f);
+
+    // Сбор статистики по принятым сканированиям
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    bool bEnableAnalytics = true;
+
+    // Длина фиксированного окна статистики (по умолчанию - минута)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Analytics", Meta = (ClampMin = "1.0"))
+    float AnalyticsWindowSeconds = 60.0f;
+
+    // Длина скользящего окна для частоты сканирований, не больше минуты
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Barcode Scanner|Analytics", Meta = (ClampMin = "1.0", ClampMax = "63.0"))
+    float AnalyticsSlidingWindowSeconds = 10.0f;
+
+    // Файл для периодической выгрузки снимков (JSON Lines); пустой путь - без выгрузки
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    FString AnalyticsDumpPath;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Analytics", Meta = (ClampMin = "1.0"))
+    float AnalyticsDumpIntervalSeconds = 60.0f;
+
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner|Analytics")
+    FScanAnalyticsSnapshot GetAnalyticsSnapshot() const;
+
+    // Оценка частоты кода в текущем окне, сканирований в секунду
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner|Analytics")
+    float GetItemScanRate(const FString& Code) const;
+
+    // Публикация сканирований в разделяемую память для локальных процессов (только Linux)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Export")
+    bool bEnableSharedMemoryExport = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Export")
+    FString SharedMemoryName = TEXT("/barcode_scanner_scans");
+
+    // Размер кольца; округляется до степени двойки
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner|Export", Meta = (ClampMin = "2"))
+    int32 SharedMemorySlotCount = 4096;
+
 private:
+    struct FScanWaiter
+    {
+        uint64 Id;
+        FBarcodeScanFilter Filter;
+        FTimerHandle TimeoutHandle;
+        TSharedRef<TPromise<TOptional<FBarcodeScanRecord>>> Promise;
+    };
+
     void InitializeScanner();
     void ProcessScannedData(const FString& Data);
+    void DrainIngestQueue();
+    void DispatchScan(const FBarcodeScanRecord& Record);
+    void ResolveWaiters(const FBarcodeScanRecord& Record);
+    void TimeoutWaiter(uint64 WaiterId);
+    void DumpAnalytics();
 
     bool bIsScannerActive;
     FString LastScannedCode;
+    FBarcodeScanRecord LastScanRecord;
+    std::atomic<int64> NextSequenceNumber { 0 };
+
+    FScanIngestQueue IngestQueue;
+    bool bHighWatermarkRaised = false;
+
+    TArray<FScanWaiter> Waiters;
+    uint64 NextWaiterId = 1;
+
+    TSharedPtr<FScanPipeline> Pipeline;
+
+    TSharedPtr<IBarcodeScannerDevice> Device;
+    FScanTraceRecorder TraceRecorder;
+    FScanInputAssembler InputAssembler;
+    FCriticalSection InputAssemblerLock;
+
+    FScanAnalytics Analytics;
+    FTimerHandle AnalyticsDumpHandle;
+    TSharedPtr<FScanAnalyticsFileWriter> AnalyticsWriter;
+
+    FScanShmExporter ShmExporter;
 }; 
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ScanTrace.h"
+
+// Приёмник сырых событий; вызывается с потока устройства
+using FScanRawEventSink = TFunction<void(const FScanRawEvent&)>;
+
+// Источник сырых событий для ABarcodeScanner (HID, клавиатурный режим, воспроизведение записи)
+class BARCODESCANNERPLUGIN_API IBarcodeScannerDevice
+{
+public:
+    virtual ~IBarcodeScannerDevice() = default;
+
+    // Начинает чтение; события передаются в Sink с любого потока
+    virtual bool Open(FScanRawEventSink Sink) = 0;
+
+    // Останавливает чтение; после возврата Sink больше не вызывается
+    virtual void Close() = 0;
+
+    // Идентификатор устройства для записей сканирований
+    virtual FString GetDeviceId() const = 0;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BarcodeScannerDevice.h"
+
+class FKeyboardWedgeInputProcessor;
+
+/**
+ * Сканер в клавиатурном режиме (keyboard wedge): перехватывает ввод Slate до виджетов
+ * и передаёт каждый символ событием Keystroke, Enter - символом CR.
+ * События приходят на игровом потоке; Open и Close вызывать с него же.
+ * Сканер неотличим от обычной клавиатуры, поэтому ловится весь ввод приложения;
+ * bConsumeInput скрывает его от виджетов и игрового ввода.
+ */
+class BARCODESCANNERPLUGIN_API FKeyboardWedgeScannerDevice : public IBarcodeScannerDevice
+{
+public:
+    explicit FKeyboardWedgeScannerDevice(const FString& InDeviceId, bool bInConsumeInput = false);
+    virtual ~FKeyboardWedgeScannerDevice() override;
+
+    // IBarcodeScannerDevice
+    virtual bool Open(FScanRawEventSink InSink) override;
+    virtual void Close() override;
+    virtual FString GetDeviceId() const override { return DeviceId; }
+
+private:
+    FString DeviceId;
+    bool bConsumeInput;
+    TSharedPtr<FKeyboardWedgeInputProcessor> Processor;
+};
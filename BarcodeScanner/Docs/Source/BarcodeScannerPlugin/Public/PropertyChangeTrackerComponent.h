@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "UObject/UnrealType.h"
+#include <type_traits>
+#include "PropertyChangeTrackerComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTrackedPropertiesChanged, const TArray<FName>&, ChangedProperties);
+
+// Компонент, собирающий изменения свойств владельца и рассылающий их одним событием за кадр
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class BARCODESCANNERPLUGIN_API UPropertyChangeTrackerComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UPropertyChangeTrackerComponent();
+
+    virtual void BeginDestroy() override;
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    // Имена отслеживаемых свойств; пустой список - все Blueprint-видимые свойства класса владельца
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Property Tracking")
+    TArray<FName> TrackedProperties;
+
+    // Одно событие за кадр со списком реально изменившихся свойств
+    UPROPERTY(BlueprintAssignable, Category = "Property Tracking")
+    FOnTrackedPropertiesChanged OnPropertiesChanged;
+
+    // Помечает свойство изменённым; повторные отметки в том же кадре схлопываются
+    UFUNCTION(BlueprintCallable, Category = "Property Tracking")
+    void MarkPropertyDirty(FName PropertyName);
+
+    // Немедленно рассылает накопленные изменения
+    UFUNCTION(BlueprintCallable, Category = "Property Tracking")
+    void FlushChanges();
+
+    // Присваивает значение и помечает свойство, только если значение действительно изменилось
+    template <typename T>
+    bool SetTrackedValue(T& Field, const T& NewValue, FName PropertyName)
+    {
+        if (Field == NewValue)
+        {
+            return false;
+        }
+        Field = NewValue;
+        MarkPropertyDirty(PropertyName);
+        return true;
+    }
+
+    // Значение свойства до последнего изменения; nullptr, если свойство не отслеживается или тип T не совпадает
+    template <typename T>
+    const T* GetPreviousValue(FName PropertyName) const
+    {
+        const uint8* Data = nullptr;
+        const FProperty* Property = FindPreviousValue(PropertyName, Data);
+        if (!Property || Property->GetSize() != sizeof(T) || !IsCompatibleProperty<T>(Property))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[PropertyChangeTracker] Property %s is not tracked or does not match the requested type"), *PropertyName.ToString());
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(Data);
+    }
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    struct FTrackedEntry
+    {
+        FProperty* Property;
+        int32 SnapshotOffset;
+    };
+
+    void BuildTrackedEntries();
+    void ReleaseSnapshot();
+    const FProperty* FindPreviousValue(FName PropertyName, const uint8*& OutData) const;
+
+    // Сверка C++ типа с типом свойства; для прочих типов достаточно совпадения размера
+    template <typename T>
+    static bool IsCompatibleProperty(const FProperty* Property)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            return Property->IsA<FBoolProperty>();
+        }
+        else if constexpr (std::is_floating_point_v<T> || std::is_integral_v<T>)
+        {
+            const FNumericProperty* Numeric = CastField<FNumericProperty>(Property);
+            return Numeric && (std::is_floating_point_v<T> ? Numeric->IsFloatingPoint() : Numeric->IsInteger());
+        }
+        else if constexpr (std::is_same_v<T, FString>)
+        {
+            return Property->IsA<FStrProperty>();
+        }
+        else if constexpr (std::is_same_v<T, FName>)
+        {
+            return Property->IsA<FNameProperty>();
+        }
+        else if constexpr (std::is_same_v<T, FText>)
+        {
+            return Property->IsA<FTextProperty>();
+        }
+        else if constexpr (TModels<CStaticStructProvider, T>::Value)
+        {
+            const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+            return StructProperty && StructProperty->Struct == T::StaticStruct();
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    TArray<FTrackedEntry> Entries;
+    TMap<FName, int32> PropertyIndices;
+    TBitArray<> DirtyBits;
+    bool bHasDirty = false;
+
+    // Отметки до BeginPlay: применяются после построения снимка и рассылаются без сравнения
+    bool bEntriesBuilt = false;
+    TArray<FName> PendingDirty;
+    TBitArray<> ForcedBits;
+
+    // Копии значений на момент последней рассылки и значения до неё
+    uint8* SnapshotData = nullptr;
+    uint8* PreviousData = nullptr;
+};
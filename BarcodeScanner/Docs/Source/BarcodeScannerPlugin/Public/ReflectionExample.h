@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "PropertyChangeTrackerComponent.h"
 #include "ReflectionExample.generated.h"
 
 UCLASS(Blueprintable) // Blueprintable позволяет создавать Blueprint на основе этого класса
@@ -24,14 +25,26 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Reflection Example")
     void SetExampleNumber(int32 NewNumber);
 
-    // Событие, которое можно реализовать в Blueprint
+    // Событие, которое можно реализовать в Blueprint (не чаще одного раза за кадр)
     UFUNCTION(BlueprintImplementableEvent, Category = "Reflection Example")
     void OnNumberChanged(int32 OldNumber, int32 NewNumber);
 
+    // Общее событие со всеми свойствами, изменившимися за кадр
+    UFUNCTION(BlueprintImplementableEvent, Category = "Reflection Example")
+    void OnPropertiesChanged(const TArray<FName>& ChangedProperties);
+
+    // Компонент, собирающий изменения свойств за кадр
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Reflection Example")
+    UPropertyChangeTrackerComponent* ChangeTracker;
+
 protected:
     virtual void BeginPlay() override;
 
 private:
     // Приватное свойство, недоступное извне
     int32 PrivateNumber;
+
+    // Обработчик пакета изменений от ChangeTracker
+    UFUNCTION()
+    void HandleTrackedPropertiesChanged(const TArray<FName>& ChangedProperties);
 }; 
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class STextBlock;
+
+// Запись в истории сканирований
+struct FScanHistoryEntry
+{
+    FString Code;
+    FDateTime Time;
+};
+
+/**
+ * Виртуализированный список последних сканирований.
+ * Записи хранятся в заранее выделенном кольцевом буфере, строки создаются только для
+ * видимой части списка. Новые сканирования не пересоздают строки: раз в кадр обновляется
+ * только текст видимых строк, после заполнения буфера источник элементов не меняется.
+ */
+class BARCODESCANNERPLUGIN_API SScanHistoryList : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SScanHistoryList)
+        : _Capacity(256)
+    {}
+        // Максимальное количество хранимых сканирований
+        SLATE_ARGUMENT(int32, Capacity)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    // Добавляет сканирование; перерисовка откладывается до следующего кадра
+    void AddScan(const FString& Code);
+    void AddScan(const FString& Code, const FDateTime& Time);
+
+    // Очищает историю
+    void ClearHistory();
+
+    int32 GetNumScans() const { return Count; }
+
+private:
+    // Элемент списка - позиция от самого нового сканирования
+    using FRowSlot = TSharedPtr<int32>;
+
+    TSharedRef<ITableRow> OnGenerateRow(FRowSlot Slot, const TSharedRef<STableViewBase>& OwnerTable);
+    EActiveTimerReturnType RefreshVisibleRows(double InCurrentTime, float InDeltaTime);
+
+    const FScanHistoryEntry* GetEntry(int32 SlotIndex) const;
+    void ApplyEntryToRow(const TSharedPtr<ITableRow>& Row, int32 SlotIndex) const;
+
+    // Кольцевой буфер записей
+    TArray<FScanHistoryEntry> Ring;
+    int32 Head = 0;
+    int32 Count = 0;
+
+    // Пул элементов списка и текущий источник элементов
+    TArray<FRowSlot> SlotPool;
+    TArray<FRowSlot> VisibleSlots;
+
+    TSharedPtr<SListView<FRowSlot>> ListView;
+    bool bRefreshPending = false;
+};
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "BarcodeScanTypes.h"
+#include <atomic>
+#include "ScanAnalytics.generated.h"
+
+// Оценка частоты одного кода
+USTRUCT(BlueprintType)
+struct BARCODESCANNERPLUGIN_API FScanAnalyticsItem
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    FString Code;
+
+    // Оценка сверху: count-min sketch не занижает частоту
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    int64 EstimatedCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    float ScansPerSecond = 0.0f;
+};
+
+// Сканирования одного устройства в текущем и предыдущем окне
+USTRUCT(BlueprintType)
+struct BARCODESCANNERPLUGIN_API FScanAnalyticsDeviceRate
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    FString DeviceId;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    int32 ScansCurrentWindow = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    int32 ScansPreviousWindow = 0;
+};
+
+// Снимок агрегатов на момент запроса
+USTRUCT(BlueprintType)
+struct BARCODESCANNERPLUGIN_API FScanAnalyticsSnapshot
+{
+    GENERATED_BODY()
+
+    // Момент снимка (UTC)
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    FDateTime SnapshotTimeUtc;
+
+    // Начало текущего окна (UTC); окна выровнены по UNIX-времени, минутное окно начинается с :00
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    FDateTime WindowStartUtc;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    int64 TotalScans = 0;
+
+    // Скользящее окно последних SlidingWindowSeconds секунд
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    float SlidingWindowSeconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    int32 SlidingWindowScans = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    float SlidingScansPerSecond = 0.0f;
+
+    // Фиксированное (tumbling) окно длиной WindowSeconds
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    float WindowSeconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    int32 CurrentWindowScans = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    int32 PreviousWindowScans = 0;
+
+    // Самые частые коды текущего окна, по убыванию
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    TArray<FScanAnalyticsItem> TopItems;
+
+    // Самые частые коды последнего завершённого окна
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    TArray<FScanAnalyticsItem> PreviousTopItems;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Analytics")
+    TArray<FScanAnalyticsDeviceRate> Devices;
+};
+
+/**
+ * Потоковая статистика сканирований в фиксированном объёме памяти.
+ * Счётчики разнесены по шардам (поток получает свой шард при первом вызове), частоты кодов
+ * оцениваются count-min sketch, самые частые коды хранятся в top-K. Ingest можно вызывать
+ * с любого потока без блокировок, кроме обновления top-K и смены окна.
+ * Границы окон не атомарны: событие на стыке окон может попасть в соседнее.
+ */
+class BARCODESCANNERPLUGIN_API FScanAnalytics
+{
+public:
+    static constexpr int32 NumShards = 16;
+    static constexpr int32 NumSecondBuckets = 64;      // Предел скользящего окна, секунд
+    static constexpr int32 NumWindowBuckets = 4;
+    static constexpr int32 MaxDevices = 16;            // Остальные устройства учитываются как "Other"
+    static constexpr int32 SketchDepth = 4;
+    static constexpr int32 SketchWidth = 2048;
+    static constexpr int32 TopK = 16;
+
+    FScanAnalytics();
+
+    // Длина фиксированного окна; вызывать до первого Ingest
+    void Configure(float InWindowSeconds);
+
+    // Текущее время на шкале агрегатора: секунды UNIX (UTC)
+    double GetWallClockSeconds() const;
+
+    // Время сканирования - ReceiveTimeSeconds, переведённое на шкалу UNIX
+    void Ingest(const FBarcodeScanRecord& Record);
+
+    // TimeSeconds - секунды UNIX (UTC)
+    void Ingest(const FString& Code, const FString& DeviceId, double TimeSeconds);
+
+    // Оценка числа сканирований кода в текущем окне
+    int64 EstimateCount(const FString& Code) const;
+
+    // Оценка частоты кода в текущем окне, сканирований в секунду
+    float EstimateRate(const FString& Code, double NowSeconds) const;
+
+    FScanAnalyticsSnapshot GetSnapshot(double NowSeconds, float SlidingWindowSeconds) const;
+
+private:
+    struct FSecondBucket
+    {
+        std::atomic<int64> Second { -1 };
+        std::atomic<uint32> Count { 0 };
+    };
+
+    struct FWindowBucket
+    {
+        std::atomic<int64> Window { -1 };
+        std::atomic<uint32> Total { 0 };
+        std::atomic<uint32> PerDevice[MaxDevices + 1] = {};
+    };
+
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+    {
+        std::atomic<uint64> Total { 0 };
+        FSecondBucket Seconds[NumSecondBuckets];
+        FWindowBucket Windows[NumWindowBuckets];
+    };
+
+    struct FHeavyHitter
+    {
+        uint64 Hash = 0;
+        FString Code;
+        uint32 Count = 0;
+    };
+
+    int32 FindDeviceSlot(const FString& DeviceId);
+    uint32 AddToSketch(uint64 Hash);
+    uint32 QuerySketch(uint64 Hash) const;
+    void RollSketch(int64 Window);
+    void UpdateHeavyHitters(const FString& Code, uint64 Hash, uint32 Estimate);
+    int64 GetWindowIndex(double TimeSeconds) const;
+    void FillItems(const TArray<FHeavyHitter>& Source, float ElapsedSeconds, TArray<FScanAnalyticsItem>& OutItems) const;
+
+    float WindowSeconds = 60.0f;
+
+    // Разница между UNIX-временем и FPlatformTime::Seconds, фиксируется в Configure.
+    // Обходится без FDateTime::UtcNow на каждое сканирование; коррекция часов системы учтётся при следующем Configure
+    double WallClockOffset = 0.0;
+
+    FShard Shards[NumShards];
+
+    // Устройства: хеш занимается через CAS, имя дописывается под DeviceNamesLock
+    std::atomic<uint64> DeviceHashes[MaxDevices] = {};
+    FString DeviceNames[MaxDevices];
+    mutable FCriticalSection DeviceNamesLock;
+
+    std::atomic<uint32> Sketch[SketchDepth * SketchWidth] = {};
+    std::atomic<int64> SketchWindow { -1 };
+
+    // Порог входа в top-K: минимум кучи при заполнении, иначе 0
+    std::atomic<uint32> HeavyThreshold { 0 };
+    mutable FCriticalSection HeavyLock;
+    TArray<FHeavyHitter> HeavyHitters;
+    TArray<FHeavyHitter> PreviousHeavyHitters;
+};
+
+/**
+ * Последовательная дозапись строк в файл с фоновых потоков.
+ * Строки пишутся в порядке Append и не перемешиваются, сколько бы фоновых записей ни шло одновременно.
+ */
+class BARCODESCANNERPLUGIN_API FScanAnalyticsFileWriter : public TSharedFromThis<FScanAnalyticsFileWriter>
+{
+public:
+    explicit FScanAnalyticsFileWriter(const FString& InFilePath);
+
+    // Ставит строку в очередь и запускает фоновую запись
+    void Append(const FString& Line);
+
+    // Записывает всё накопленное на вызывающем потоке
+    void Flush();
+
+private:
+    FString FilePath;
+
+    FCriticalSection PendingLock;
+    FString PendingText;
+
+    // Удерживается на время записи в файл: порядок строк сохраняется между потоками
+    FCriticalSection WriteLock;
+};
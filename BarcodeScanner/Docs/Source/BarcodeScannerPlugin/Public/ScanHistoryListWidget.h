@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "BarcodeScanTypes.h"
+#include "ScanHistoryListWidget.generated.h"
+
+class SScanHistoryList;
+class ABarcodeScanner;
+
+// UMG-обёртка над SScanHistoryList для использования в WBP_BarcodeScannerWidget
+UCLASS()
+class BARCODESCANNERPLUGIN_API UScanHistoryListWidget : public UWidget
+{
+    GENERATED_BODY()
+
+public:
+    // Максимальное количество хранимых сканирований
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Barcode Scanner", Meta = (ClampMin = "1"))
+    int32 Capacity = 256;
+
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner")
+    void AddScan(const FString& Code);
+
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner")
+    void ClearHistory();
+
+    // Подписывает список на сканер, чтобы Blueprint не обновлял его вручную
+    UFUNCTION(BlueprintCallable, Category = "Barcode Scanner")
+    void BindToScanner(ABarcodeScanner* Scanner);
+
+    virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+protected:
+    virtual TSharedRef<SWidget> RebuildWidget() override;
+
+private:
+    void HandleScan(const FBarcodeScanRecord& Record);
+
+    TSharedPtr<SScanHistoryList> HistoryList;
+
+    TWeakObjectPtr<ABarcodeScanner> BoundScanner;
+    FDelegateHandle ScanHandle;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "BarcodeScanTypes.h"
+#include "ScanIngestQueue.generated.h"
+
+class FEvent;
+
+// Поведение при переполнении очереди приёма
+UENUM(BlueprintType)
+enum class EScanOverloadPolicy : uint8
+{
+    DropOldest   UMETA(DisplayName = "Drop Oldest"),    // Вытеснить самое старое сканирование
+    DropNewest   UMETA(DisplayName = "Drop Newest"),    // Отбросить пришедшее сканирование
+    BlockReader  UMETA(DisplayName = "Block Reader")    // Остановить поток чтения до освобождения места
+};
+
+// Счётчики очереди приёма
+USTRUCT(BlueprintType)
+struct BARCODESCANNERPLUGIN_API FScanIngestStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Ingest")
+    int32 QueueDepth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Ingest")
+    int32 PeakQueueDepth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Ingest")
+    int32 QueueCapacity = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Ingest")
+    int64 Accepted = 0;
+
+    // Потерянные при переполнении сканирования
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Ingest")
+    int64 Dropped = 0;
+
+    // Сканирования, не выданные в кадре поступления, и ожидания потока чтения
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Ingest")
+    int64 Delayed = 0;
+};
+
+/**
+ * Ограниченная потокобезопасная очередь между потоком чтения сканера и выдачей на игровом потоке.
+ * Записывать можно с любого потока; читает только игровой поток. Режим BlockReader
+ * блокирует только фоновые потоки: на игровом потоке он работает как DropNewest.
+ */
+class BARCODESCANNERPLUGIN_API FScanIngestQueue
+{
+public:
+    FScanIngestQueue();
+    ~FScanIngestQueue();
+
+    void Configure(int32 Capacity, EScanOverloadPolicy Policy, float BlockTimeoutSeconds);
+
+    // Ставит сканирование в очередь; false - сканирование потеряно
+    bool Enqueue(const FBarcodeScanRecord& Record);
+
+    // Копирует первое сканирование без извлечения
+    bool PeekFront(FBarcodeScanRecord& OutRecord) const;
+
+    // Извлекает первое сканирование, если это всё ещё ожидаемое (его могло вытеснить DropOldest)
+    bool PopFront(int64 ExpectedSequenceNumber);
+
+    // Передаёт первое сканирование Consumer под блокировкой очереди и извлекает его, если Consumer вернул true.
+    // Consumer не должен обращаться к очереди
+    bool TryConsumeFront(TFunctionRef<bool(const FBarcodeScanRecord&)> Consumer);
+
+    // Помечает оставшиеся в очереди сканирования как задержанные
+    void MarkRemainingDelayed();
+
+    // Пиковая глубина с прошлого вызова
+    int32 ConsumePeakDepth();
+
+    // Будит заблокированные потоки чтения; дальнейшие записи отбрасываются
+    void Shutdown();
+
+    FScanIngestStats GetStats() const;
+
+private:
+    struct FItem
+    {
+        FBarcodeScanRecord Record;
+        bool bDelayed = false;
+    };
+
+    mutable FCriticalSection Lock;
+    TArray<FItem> Ring;
+    int32 Head = 0;
+    int32 Num = 0;
+
+    EScanOverloadPolicy Policy = EScanOverloadPolicy::DropOldest;
+    float BlockTimeoutSeconds = 1.0f;
+    bool bShutdown = false;
+
+    // Событие с ручным сбросом; сбрасывает его ждущий читатель под Lock
+    FEvent* SpaceAvailable = nullptr;
+
+    int32 PeakDepth = 0;
+    int32 PeakDepthSinceCheck = 0;
+    int64 Accepted = 0;
+    int64 Dropped = 0;
+    int64 Delayed = 0;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "BarcodeScanTypes.h"
+#include <atomic>
+#include "ScanPipeline.generated.h"
+
+// Поток, на котором выполняется стадия обработки
+UENUM(BlueprintType)
+enum class EScanStageAffinity : uint8
+{
+    AnyThread   UMETA(DisplayName = "Any Thread"),   // Фоновые рабочие потоки
+    GameThread  UMETA(DisplayName = "Game Thread")   // Игровой поток (доступ к UObject)
+};
+
+// Статистика одной стадии
+USTRUCT(BlueprintType)
+struct BARCODESCANNERPLUGIN_API FScanPipelineStageStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Pipeline")
+    FName StageName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Pipeline")
+    int32 QueueDepth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Pipeline")
+    int32 PeakQueueDepth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Pipeline")
+    int32 QueueCapacity = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Pipeline")
+    int64 Processed = 0;
+
+    // Сканирования, отклонённые стадией
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Pipeline")
+    int64 Rejected = 0;
+
+    // Ожидание в очереди плюс обработка
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Pipeline")
+    float AverageLatencyMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Barcode Scanner|Pipeline")
+    float MaxLatencyMs = 0.0f;
+};
+
+// Функция стадии: может изменить запись; false - сканирование отбрасывается
+using FScanStageFunction = TFunction<bool(FBarcodeScanRecord&)>;
+
+/**
+ * Конвейер обработки сканирований.
+ * Стадии соединены ограниченными очередями. Рабочий поток стадии забирает сканирование,
+ * только зарезервировав место в очереди следующей стадии, поэтому переполнение
+ * распространяется назад до Submit, который в этом случае возвращает false.
+ * Результаты собираются в порядке Submit и выдаются на игровом потоке через OnScanCompleted.
+ */
+class BARCODESCANNERPLUGIN_API FScanPipeline : public TSharedFromThis<FScanPipeline>
+{
+public:
+    DECLARE_DELEGATE_OneParam(FOnScanCompleted, const FBarcodeScanRecord&);
+
+    ~FScanPipeline();
+
+    // Регистрирует стадию; вызывать до начала сканирования
+    void AddStage(FName StageName, EScanStageAffinity Affinity, FScanStageFunction Function, int32 QueueCapacity = 64, int32 MaxWorkers = 1);
+
+    bool HasStages() const { return Stages.Num() > 0; }
+
+    // Ставит сканирование в очередь первой стадии; false - очередь заполнена
+    bool Submit(const FBarcodeScanRecord& Record);
+
+    // Останавливает рабочие потоки; необработанные сканирования отбрасываются
+    void Shutdown();
+
+    TArray<FScanPipelineStageStats> GetStats() const;
+
+    // Вызывается на игровом потоке в порядке Submit
+    FOnScanCompleted OnScanCompleted;
+
+private:
+    struct FPendingScan
+    {
+        int64 PipelineIndex = 0;
+        FBarcodeScanRecord Record;
+        double EnqueueTime = 0.0;
+    };
+
+    struct FStage;
+
+    bool TryReserve(int32 StageIndex);
+    bool HasRoom(int32 StageIndex) const;
+    void ReleaseReservation(int32 StageIndex);
+    void Push(int32 StageIndex, FPendingScan&& Scan);
+    void KickStage(int32 StageIndex);
+    void RunStage(int32 StageIndex);
+    void Complete(int64 PipelineIndex, TOptional<FBarcodeScanRecord>&& Result);
+    void DispatchCompleted();
+
+    TArray<TUniquePtr<FStage>> Stages;
+
+    // Буфер переупорядочивания: готовые результаты ждут, пока не выйдут все предыдущие
+    mutable FCriticalSection ReorderLock;
+    TMap<int64, TOptional<FBarcodeScanRecord>> Completed;
+    int64 NextSubmitIndex = 0;
+    int64 NextDispatchIndex = 0;
+
+    std::atomic<bool> bDispatchScheduled { false };
+    std::atomic<bool> bShutdown { false };
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "BarcodeScanTypes.h"
+#include "ScanPreloadComponent.generated.h"
+
+class ABarcodeScanner;
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnScanItemAssetsReady, const FString&, Code);
+
+// Ассеты товара и группа (паллета, заказ), по которой подгружаются соседние товары
+USTRUCT(BlueprintType)
+struct BARCODESCANNERPLUGIN_API FScanPreloadItem
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scan Preload")
+    TArray<TSoftObjectPtr<UObject>> Assets;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scan Preload")
+    FName GroupId;
+};
+
+// Счётчики кеша предзагрузки
+USTRUCT(BlueprintType)
+struct BARCODESCANNERPLUGIN_API FScanPreloadStats
+{
+    GENERATED_BODY()
+
+    // Ассеты были загружены к моменту сканирования
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    int64 Hits = 0;
+
+    // Загрузка уже шла, но не завершилась
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    int64 InFlightHits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    int64 Misses = 0;
+
+    // Доли от всех сканирований товаров каталога; в сумме дают 1
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    float HitRatio = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    float InFlightRatio = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    float MissRatio = 0.0f;
+
+    // Попадания благодаря предсказанию по истории или группе
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    int64 PrefetchHits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    int64 PrefetchRequests = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    int64 Evictions = 0;
+
+    // Время от запроса до завершения асинхронной загрузки
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    float AverageLoadMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    float MaxLoadMs = 0.0f;
+
+    // Ожидание от сканирования до готовности ассетов для промахов и незавершённых загрузок
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    float AverageScanWaitMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    int32 CachedItems = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    int32 PendingLoads = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scan Preload")
+    float CachedMemoryMB = 0.0f;
+};
+
+/**
+ * Асинхронная предзагрузка ассетов отсканированных товаров. Подписывается на
+ * OnBarcodePreDispatch ABarcodeScanner, чтобы загрузка стартовала до обработчиков Blueprint.
+ * Загружает через FStreamableManager и держит ассеты в LRU-кеше с ограничением по числу
+ * и памяти. По истории сканирований и группам заранее подгружает товары, которые вероятно
+ * отсканируют следующими. Blueprint вместо синхронной загрузки ждёт OnItemAssetsReady
+ * и берёт ассеты через GetItemAssets.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class BARCODESCANNERPLUGIN_API UScanPreloadComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UScanPreloadComponent();
+
+    // Соответствие кодов ассетам товаров
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Scan Preload")
+    TMap<FString, FScanPreloadItem> ItemAssets;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scan Preload", Meta = (ClampMin = "1"))
+    int32 MaxCachedItems = 32;
+
+    // Оценка по GetResourceSizeBytes; общие для товаров ассеты учитываются у каждого
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scan Preload", Meta = (ClampMin = "1.0"))
+    float MaxCacheMemoryMB = 256.0f;
+
+    // Сколько связанных товаров подгружать после одного сканирования (0 - без предсказания)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scan Preload", Meta = (ClampMin = "0"))
+    int32 MaxPrefetchPerScan = 4;
+
+    // Готовность ассетов товара, запрошенного сканированием
+    UPROPERTY(BlueprintAssignable, Category = "Scan Preload")
+    FOnScanItemAssetsReady OnItemAssetsReady;
+
+    // Подписка на сканер; по умолчанию - на владельца, если это ABarcodeScanner
+    UFUNCTION(BlueprintCallable, Category = "Scan Preload")
+    void BindToScanner(ABarcodeScanner* Scanner);
+
+    // Добавляет или заменяет товар, например из каталога, полученного во время работы
+    UFUNCTION(BlueprintCallable, Category = "Scan Preload")
+    void RegisterItem(const FString& Code, const FScanPreloadItem& Item);
+
+    // Загрузка без сканирования; не влияет на счётчики попаданий
+    UFUNCTION(BlueprintCallable, Category = "Scan Preload")
+    void RequestPreload(const FString& Code);
+
+    UFUNCTION(BlueprintCallable, Category = "Scan Preload")
+    bool IsItemReady(const FString& Code) const;
+
+    // Загруженные ассеты товара; false, если загрузка не завершена
+    UFUNCTION(BlueprintCallable, Category = "Scan Preload")
+    bool GetItemAssets(const FString& Code, TArray<UObject*>& OutAssets) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Scan Preload")
+    FScanPreloadStats GetPreloadStats() const;
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    struct FCacheEntry
+    {
+        TSharedPtr<FStreamableHandle> Handle;
+        uint64 RequestId = 0;
+        uint64 LastUse = 0;
+        double RequestTime = 0.0;
+        double ScanWaitStart = 0.0;
+        int64 SizeBytes = 0;
+        bool bLoaded = false;
+        bool bPrefetched = false;
+        bool bNotifyWhenLoaded = false;
+    };
+
+    // Товары, сканировавшиеся следом за данным, с числом повторений
+    struct FSuccessor
+    {
+        FString Code;
+        int32 Count = 0;
+    };
+
+    static constexpr int32 MaxSuccessorsPerItem = 4;
+
+    void HandleScan(const FBarcodeScanRecord& Record);
+    void StartLoad(const FString& Code, bool bPrefetch, bool bNotifyWhenLoaded);
+    void ReleaseEntry(FCacheEntry& Entry);
+    void HandleLoadCompleted(FString Code, uint64 RequestId);
+    void PrefetchRelated(const FString& Code);
+    void LearnTransition(const FString& FromCode, const FString& ToCode);
+    void EvictToLimits(const FString& ProtectedCode);
+    void RemoveFromGroup(const FString& Code);
+
+    TMap<FString, FCacheEntry> Cache;
+    TMap<FString, TArray<FSuccessor>> Successors;
+    TMap<FName, TArray<FString>> GroupMembers;
+    FString PreviousScanCode;
+    uint64 UseCounter = 0;
+    uint64 NextRequestId = 1;
+    int64 CachedBytes = 0;
+    int32 PendingLoads = 0;
+
+    TWeakObjectPtr<ABarcodeScanner> BoundScanner;
+    FDelegateHandle ScanHandle;
+
+    int64 Hits = 0;
+    int64 InFlightHits = 0;
+    int64 Misses = 0;
+    int64 PrefetchHits = 0;
+    int64 PrefetchRequests = 0;
+    int64 Evictions = 0;
+    int64 CompletedLoads = 0;
+    double TotalLoadSeconds = 0.0;
+    double MaxLoadSeconds = 0.0;
+    int64 ScanWaits = 0;
+    double TotalScanWaitSeconds = 0.0;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BarcodeScanTypes.h"
+
+namespace ScanShm
+{
+    struct FHeader;
+    struct FSlot;
+}
+
+/**
+ * Публикация обработанных сканирований в кольцо разделяемой памяти POSIX для локальных процессов.
+ * Один писатель, сколько угодно читателей; раскладка - ScanShmReader/ScanShmLayout.h,
+ * библиотека чтения - ScanShmReader. Поддерживается только на Linux, на остальных платформах Open возвращает false.
+ */
+class BARCODESCANNERPLUGIN_API FScanShmExporter
+{
+public:
+    ~FScanShmExporter();
+
+    // Создаёт сегмент заново; SlotCount округляется вверх до степени двойки
+    bool Open(const FString& Name, int32 SlotCount);
+
+    // Помечает сегмент закрытым и удаляет имя; подключённые читатели дочитывают хвост
+    void Close();
+
+    bool IsOpen() const { return Header != nullptr; }
+
+    // Публикует запись без блокировок и системных вызовов; вызывать с одного потока
+    void Publish(const FBarcodeScanRecord& Record);
+
+    int64 GetPublishedCount() const { return (int64)(NextSequence - 1); }
+
+private:
+    ScanShm::FHeader* Header = nullptr;
+    ScanShm::FSlot* Slots = nullptr;
+    SIZE_T MappedSize = 0;
+    uint64 NextSequence = 1;
+    FString SegmentName;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FArchive;
+
+// Тип сырого события сканера
+enum class EScanRawEventKind : uint8
+{
+    HidReport = 0,   // Отчёт HID POS: полезная нагрузка - байты кода в UTF-8
+    Keystroke = 1    // Клавиатурный режим: полезная нагрузка - один символ в UTF-8
+};
+
+// Сырое событие устройства с меткой времени высокого разрешения
+struct FScanRawEvent
+{
+    EScanRawEventKind Kind = EScanRawEventKind::HidReport;
+    double TimeSeconds = 0.0;
+    TArray<uint8> Payload;
+};
+
+/**
+ * Собирает сырые события в готовые коды: отчёт HID - один код,
+ * нажатия клавиш накапливаются до Enter (CR или LF).
+ */
+class BARCODESCANNERPLUGIN_API FScanInputAssembler
+{
+public:
+    // Возвращает true и код, если событие завершило сканирование
+    bool Feed(const FScanRawEvent& Event, FString& OutData);
+
+private:
+    TArray<uint8> PendingKeystrokes;
+};
+
+/**
+ * Запись сырого потока событий в компактный бинарный файл.
+ * Формат: заголовок (сигнатура, версия, время начала, устройство), затем события:
+ * varint дельты времени в микросекундах, байт типа, varint длины и полезная нагрузка.
+ * Record можно вызывать с любого потока.
+ */
+class BARCODESCANNERPLUGIN_API FScanTraceRecorder
+{
+public:
+    ~FScanTraceRecorder();
+
+    bool Open(const FString& FilePath, const FString& DeviceId);
+    void Record(const FScanRawEvent& Event);
+    void Close();
+
+    bool IsRecording() const;
+
+private:
+    mutable FCriticalSection Lock;
+    TUniquePtr<FArchive> Writer;
+    double StartTimeSeconds = 0.0;
+    uint64 LastEventMicros = 0;
+    int64 EventCount = 0;
+};
+
+// Чтение файла записи целиком в память
+class BARCODESCANNERPLUGIN_API FScanTraceReader
+{
+public:
+    bool Load(const FString& FilePath);
+
+    // Следующее событие; TimeSeconds отсчитывается от начала записи
+    bool Next(FScanRawEvent& OutEvent);
+
+    const FString& GetDeviceId() const { return DeviceId; }
+
+private:
+    bool ReadVarInt(uint64& OutValue);
+
+    TArray<uint8> Data;
+    int32 Offset = 0;
+    uint64 CurrentMicros = 0;
+    FString DeviceId;
+};
+
+namespace ScanTrace
+{
+    constexpr uint32 Magic = 0x54435342; // "BSCT"
+    constexpr uint16 Version = 1;
+}
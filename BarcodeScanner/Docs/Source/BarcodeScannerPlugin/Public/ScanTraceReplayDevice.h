@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "BarcodeScannerDevice.h"
+#include <atomic>
+
+class FRunnableThread;
+
+/**
+ * Устройство, воспроизводящее файл записи FScanTraceRecorder на отдельном потоке.
+ * SpeedMultiplier: 1 - исходный темп, N - ускорение в N раз, 0 - без пауз.
+ * Не зависит от рендеринга и ввода, поэтому работает в headless-сборке.
+ */
+class BARCODESCANNERPLUGIN_API FScanTraceReplayDevice : public IBarcodeScannerDevice, public FRunnable
+{
+public:
+    FScanTraceReplayDevice(const FString& InFilePath, float InSpeedMultiplier);
+    virtual ~FScanTraceReplayDevice() override;
+
+    // IBarcodeScannerDevice
+    virtual bool Open(FScanRawEventSink InSink) override;
+    virtual void Close() override;
+    virtual FString GetDeviceId() const override { return DeviceId; }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopRequested = true; }
+
+    bool IsFinished() const { return bFinished; }
+
+private:
+    FString FilePath;
+    float SpeedMultiplier;
+    FString DeviceId;
+
+    FScanTraceReader Reader;
+    FScanRawEventSink Sink;
+    FRunnableThread* Thread = nullptr;
+
+    std::atomic<bool> bStopRequested { false };
+    std::atomic<bool> bFinished { false };
+};
@@ -0,0 +1,312 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CameraFramingSolver.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Math/RotationMatrix.h"
+
+namespace
+{
+    // Размер блока акторов на одну задачу редукции
+    constexpr int32 FramingChunkSize = 8192;
+
+    // Частичный результат редукции: максимальная требуемая дистанция по каждой плоскости
+    struct FFramingPartial
+    {
+        float Right = -MAX_FLT;
+        float Left = -MAX_FLT;
+        float Top = -MAX_FLT;
+        float Bottom = -MAX_FLT;
+        float Near = -MAX_FLT;
+    };
+
+    // Опорная функция вертикального цилиндра на оси облёта в направлении с горизонтальной
+    // длиной Horizontal и вертикальной составляющей Vertical, минус проекция его центра
+    FORCEINLINE float CylinderReach(float Horizontal, float Vertical, float Radius, float HalfHeight, float CenterZ)
+    {
+        return Horizontal * Radius + FMath::Abs(Vertical) * HalfHeight - Vertical * CenterZ;
+    }
+}
+
+void FCameraFramingBuffer::Reset(int32 ExpectedNum)
+{
+    for (TArray<float>* Stream : { &CenterX, &CenterY, &CenterZ,
+                                   &AxisXX, &AxisXY, &AxisXZ,
+                                   &AxisYX, &AxisYY, &AxisYZ,
+                                   &AxisZX, &AxisZY, &AxisZZ })
+    {
+        Stream->Reset(ExpectedNum);
+    }
+    MergedBounds = FBox(ForceInit);
+}
+
+void FCameraFramingBuffer::Add(const FVector& Center, const FVector& HalfAxisX, const FVector& HalfAxisY, const FVector& HalfAxisZ)
+{
+    CenterX.Add(Center.X);
+    CenterY.Add(Center.Y);
+    CenterZ.Add(Center.Z);
+    AxisXX.Add(HalfAxisX.X);
+    AxisXY.Add(HalfAxisX.Y);
+    AxisXZ.Add(HalfAxisX.Z);
+    AxisYX.Add(HalfAxisY.X);
+    AxisYY.Add(HalfAxisY.Y);
+    AxisYZ.Add(HalfAxisY.Z);
+    AxisZX.Add(HalfAxisZ.X);
+    AxisZY.Add(HalfAxisZ.Y);
+    AxisZZ.Add(HalfAxisZ.Z);
+
+    // Мировой AABB ориентированного бокса нужен только для точки фокуса
+    const FVector WorldExtent = HalfAxisX.GetAbs() + HalfAxisY.GetAbs() + HalfAxisZ.GetAbs();
+    MergedBounds += FBox(Center - WorldExtent, Center + WorldExtent);
+}
+
+FCameraFramingResult FCameraFramingSolver::Solve(
+    const FCameraFramingBuffer& Buffer,
+    const FRotator& ViewRotation,
+    float HorizontalFOVDegrees,
+    float AspectRatio,
+    float NearClipDistance,
+    float PaddingPercent)
+{
+    FCameraFramingResult Result;
+
+    const int32 Count = Buffer.Num();
+    if (Count == 0 || AspectRatio <= KINDA_SMALL_NUMBER)
+    {
+        return Result;
+    }
+
+    const FRotationMatrix ViewMatrix(ViewRotation);
+    const FVector Forward = ViewMatrix.GetUnitAxis(EAxis::X);
+    const FVector Right = ViewMatrix.GetUnitAxis(EAxis::Y);
+    const FVector Up = ViewMatrix.GetUnitAxis(EAxis::Z);
+
+    // Отступ сужает эффективный угол обзора
+    const float Padding = 1.0f + FMath::Max(PaddingPercent, 0.0f) / 100.0f;
+    const float TanHalfH = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(HorizontalFOVDegrees, 1.0f, 170.0f) * 0.5f)) / Padding;
+    const float TanHalfV = TanHalfH / AspectRatio;
+
+    float SinH, CosH, SinV, CosV;
+    FMath::SinCos(&SinH, &CosH, FMath::Atan(TanHalfH));
+    FMath::SinCos(&SinV, &CosV, FMath::Atan(TanHalfV));
+    const float InvSinH = 1.0f / SinH;
+    const float InvSinV = 1.0f / SinV;
+
+    const FVector Pivot = Buffer.GetPivotPoint();
+
+    const int32 ChunkCount = FMath::DivideAndRoundUp(Count, FramingChunkSize);
+    TArray<FFramingPartial> Partials;
+    Partials.SetNum(ChunkCount);
+
+    ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+    {
+        const int32 Begin = ChunkIndex * FramingChunkSize;
+        const int32 End = FMath::Min(Begin + FramingChunkSize, Count);
+
+        FFramingPartial Partial;
+        for (int32 Index = Begin; Index < End; ++Index)
+        {
+            const float DX = Buffer.CenterX[Index] - Pivot.X;
+            const float DY = Buffer.CenterY[Index] - Pivot.Y;
+            const float DZ = Buffer.CenterZ[Index] - Pivot.Z;
+
+            // Проекции центра на оси камеры
+            const float CF = DX * Forward.X + DY * Forward.Y + DZ * Forward.Z;
+            const float CR = DX * Right.X + DY * Right.Y + DZ * Right.Z;
+            const float CU = DX * Up.X + DY * Up.Y + DZ * Up.Z;
+
+            // Проекции полуосей на оси камеры
+            const float XF = Buffer.AxisXX[Index] * Forward.X + Buffer.AxisXY[Index] * Forward.Y + Buffer.AxisXZ[Index] * Forward.Z;
+            const float XR = Buffer.AxisXX[Index] * Right.X + Buffer.AxisXY[Index] * Right.Y + Buffer.AxisXZ[Index] * Right.Z;
+            const float XU = Buffer.AxisXX[Index] * Up.X + Buffer.AxisXY[Index] * Up.Y + Buffer.AxisXZ[Index] * Up.Z;
+            const float YF = Buffer.AxisYX[Index] * Forward.X + Buffer.AxisYY[Index] * Forward.Y + Buffer.AxisYZ[Index] * Forward.Z;
+            const float YR = Buffer.AxisYX[Index] * Right.X + Buffer.AxisYY[Index] * Right.Y + Buffer.AxisYZ[Index] * Right.Z;
+            const float YU = Buffer.AxisYX[Index] * Up.X + Buffer.AxisYY[Index] * Up.Y + Buffer.AxisYZ[Index] * Up.Z;
+            const float ZF = Buffer.AxisZX[Index] * Forward.X + Buffer.AxisZY[Index] * Forward.Y + Buffer.AxisZZ[Index] * Forward.Z;
+            const float ZR = Buffer.AxisZX[Index] * Right.X + Buffer.AxisZY[Index] * Right.Y + Buffer.AxisZZ[Index] * Right.Z;
+            const float ZU = Buffer.AxisZX[Index] * Up.X + Buffer.AxisZY[Index] * Up.Y + Buffer.AxisZZ[Index] * Up.Z;
+
+            // Нормали боковых плоскостей: Forward * sin - Side * cos (и с плюсом для противоположной)
+            const float RightSupport = FMath::Abs(SinH * XF - CosH * XR) + FMath::Abs(SinH * YF - CosH * YR) + FMath::Abs(SinH * ZF - CosH * ZR);
+            const float LeftSupport = FMath::Abs(SinH * XF + CosH * XR) + FMath::Abs(SinH * YF + CosH * YR) + FMath::Abs(SinH * ZF + CosH * ZR);
+            const float TopSupport = FMath::Abs(SinV * XF - CosV * XU) + FMath::Abs(SinV * YF - CosV * YU) + FMath::Abs(SinV * ZF - CosV * ZU);
+            const float BottomSupport = FMath::Abs(SinV * XF + CosV * XU) + FMath::Abs(SinV * YF + CosV * YU) + FMath::Abs(SinV * ZF + CosV * ZU);
+            const float ForwardSupport = FMath::Abs(XF) + FMath::Abs(YF) + FMath::Abs(ZF);
+
+            Partial.Right = FMath::Max(Partial.Right, (RightSupport - (SinH * CF - CosH * CR)) * InvSinH);
+            Partial.Left = FMath::Max(Partial.Left, (LeftSupport - (SinH * CF + CosH * CR)) * InvSinH);
+            Partial.Top = FMath::Max(Partial.Top, (TopSupport - (SinV * CF - CosV * CU)) * InvSinV);
+            Partial.Bottom = FMath::Max(Partial.Bottom, (BottomSupport - (SinV * CF + CosV * CU)) * InvSinV);
+            Partial.Near = FMath::Max(Partial.Near, ForwardSupport - CF);
+        }
+
+        Partials[ChunkIndex] = Partial;
+    });
+
+    FFramingPartial Total;
+    for (const FFramingPartial& Partial : Partials)
+    {
+        Total.Right = FMath::Max(Total.Right, Partial.Right);
+        Total.Left = FMath::Max(Total.Left, Partial.Left);
+        Total.Top = FMath::Max(Total.Top, Partial.Top);
+        Total.Bottom = FMath::Max(Total.Bottom, Partial.Bottom);
+        Total.Near = FMath::Max(Total.Near, Partial.Near);
+    }
+
+    // Сдвиг фокуса уравнивает запасы противоположных плоскостей
+    const float ShiftRight = (Total.Right - Total.Left) * 0.5f * TanHalfH;
+    const float ShiftUp = (Total.Top - Total.Bottom) * 0.5f * TanHalfV;
+    const float HorizontalDistance = (Total.Right + Total.Left) * 0.5f;
+    const float VerticalDistance = (Total.Top + Total.Bottom) * 0.5f;
+
+    Result.Distance = FMath::Max3(HorizontalDistance, VerticalDistance, Total.Near + NearClipDistance);
+    Result.FocusPoint = Pivot + Right * ShiftRight + Up * ShiftUp;
+    Result.CameraLocation = Result.FocusPoint - Forward * Result.Distance;
+    Result.bValid = true;
+    return Result;
+}
+
+FCameraFramingResult FCameraFramingSolver::SolveOrbit(
+    const FCameraFramingBuffer& Buffer,
+    const FRotator& ViewRotation,
+    float HorizontalFOVDegrees,
+    float AspectRatio,
+    float NearClipDistance,
+    float PaddingPercent)
+{
+    FCameraFramingResult Result;
+
+    const int32 Count = Buffer.Num();
+    if (Count == 0 || AspectRatio <= KINDA_SMALL_NUMBER)
+    {
+        return Result;
+    }
+
+    // Вид при нулевом рыскании: остальные получаются поворотом вокруг вертикали, которому цилиндры безразличны
+    float SinPitch, CosPitch;
+    FMath::SinCos(&SinPitch, &CosPitch, FMath::DegreesToRadians(FMath::Clamp(ViewRotation.Pitch, -89.0f, 89.0f)));
+    const FVector Forward(CosPitch, 0.0f, SinPitch);
+    const FVector Up(-SinPitch, 0.0f, CosPitch);
+
+    const float Padding = 1.0f + FMath::Max(PaddingPercent, 0.0f) / 100.0f;
+    const float TanHalfH = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(HorizontalFOVDegrees, 1.0f, 170.0f) * 0.5f)) / Padding;
+    const float TanHalfV = TanHalfH / AspectRatio;
+
+    float SinH, CosH, SinV, CosV;
+    FMath::SinCos(&SinH, &CosH, FMath::Atan(TanHalfH));
+    FMath::SinCos(&SinV, &CosV, FMath::Atan(TanHalfV));
+    const float InvSinH = 1.0f / SinH;
+    const float InvSinV = 1.0f / SinV;
+
+    // Нормали боковых плоскостей разложены на горизонтальную длину и вертикальную составляющую.
+    // Левая и правая симметричны относительно оси, поэтому считаются один раз
+    const FVector SideNormal(SinH * Forward.X, CosH, SinH * Forward.Z);
+    const FVector TopNormal = SinV * Forward - CosV * Up;
+    const FVector BottomNormal = SinV * Forward + CosV * Up;
+    const float SideH = FVector2D(SideNormal.X, SideNormal.Y).Size();
+    const float TopH = FMath::Abs(TopNormal.X);
+    const float BottomH = FMath::Abs(BottomNormal.X);
+
+    const FVector Pivot = Buffer.GetPivotPoint();
+
+    const int32 ChunkCount = FMath::DivideAndRoundUp(Count, FramingChunkSize);
+    TArray<FFramingPartial> Partials;
+    Partials.SetNum(ChunkCount);
+
+    ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+    {
+        const int32 Begin = ChunkIndex * FramingChunkSize;
+        const int32 End = FMath::Min(Begin + FramingChunkSize, Count);
+
+        FFramingPartial Partial;
+        for (int32 Index = Begin; Index < End; ++Index)
+        {
+            // Радиус цилиндра - с запасом через неравенство треугольника, без перебора вершин
+            const float DX = Buffer.CenterX[Index] - Pivot.X;
+            const float DY = Buffer.CenterY[Index] - Pivot.Y;
+            const float DZ = Buffer.CenterZ[Index] - Pivot.Z;
+            const float Radius = FMath::Sqrt(DX * DX + DY * DY)
+                + FMath::Sqrt(Buffer.AxisXX[Index] * Buffer.AxisXX[Index] + Buffer.AxisXY[Index] * Buffer.AxisXY[Index])
+                + FMath::Sqrt(Buffer.AxisYX[Index] * Buffer.AxisYX[Index] + Buffer.AxisYY[Index] * Buffer.AxisYY[Index])
+                + FMath::Sqrt(Buffer.AxisZX[Index] * Buffer.AxisZX[Index] + Buffer.AxisZY[Index] * Buffer.AxisZY[Index]);
+            const float HalfHeight = FMath::Abs(Buffer.AxisXZ[Index]) + FMath::Abs(Buffer.AxisYZ[Index]) + FMath::Abs(Buffer.AxisZZ[Index]);
+
+            Partial.Right = FMath::Max(Partial.Right, CylinderReach(SideH, SideNormal.Z, Radius, HalfHeight, DZ) * InvSinH);
+            Partial.Top = FMath::Max(Partial.Top, CylinderReach(TopH, TopNormal.Z, Radius, HalfHeight, DZ) * InvSinV);
+            Partial.Bottom = FMath::Max(Partial.Bottom, CylinderReach(BottomH, BottomNormal.Z, Radius, HalfHeight, DZ) * InvSinV);
+            Partial.Near = FMath::Max(Partial.Near, CylinderReach(CosPitch, SinPitch, Radius, HalfHeight, DZ));
+        }
+
+        Partials[ChunkIndex] = Partial;
+    });
+
+    FFramingPartial Total;
+    for (const FFramingPartial& Partial : Partials)
+    {
+        Total.Right = FMath::Max(Total.Right, Partial.Right);
+        Total.Top = FMath::Max(Total.Top, Partial.Top);
+        Total.Bottom = FMath::Max(Total.Bottom, Partial.Bottom);
+        Total.Near = FMath::Max(Total.Near, Partial.Near);
+    }
+
+    Result.Distance = FMath::Max(FMath::Max3(Total.Right, Total.Top, Total.Bottom), Total.Near + NearClipDistance);
+    Result.FocusPoint = Pivot;
+    Result.CameraLocation = Pivot - FRotator(ViewRotation.Pitch, ViewRotation.Yaw, 0.0f).Vector() * Result.Distance;
+    Result.bValid = true;
+    return Result;
+}
+
+namespace
+{
+    // Время подбора на синтетической сцене: Camera.Framing.Benchmark [Boxes] [Iterations]
+    void RunFramingBenchmark(const TArray<FString>& Args)
+    {
+        const int32 NumBoxes = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100000;
+        const int32 NumIterations = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 1000) : 20;
+
+        // Стеллажи склада: повёрнутые боксы в квадрате 100 м, буфер готовится заранее
+        FRandomStream Random(12345);
+        FCameraFramingBuffer Buffer;
+        Buffer.Reset(NumBoxes);
+        for (int32 Index = 0; Index < NumBoxes; ++Index)
+        {
+            const FQuat Rotation(FVector::UpVector, Random.FRandRange(0.0f, 2.0f * PI));
+            const FVector Extent(Random.FRandRange(20.0f, 200.0f), Random.FRandRange(20.0f, 60.0f), Random.FRandRange(50.0f, 300.0f));
+            Buffer.Add(
+                FVector(Random.FRandRange(-5000.0f, 5000.0f), Random.FRandRange(-5000.0f, 5000.0f), Extent.Z),
+                Rotation.RotateVector(FVector(Extent.X, 0.0f, 0.0f)),
+                Rotation.RotateVector(FVector(0.0f, Extent.Y, 0.0f)),
+                Rotation.RotateVector(FVector(0.0f, 0.0f, Extent.Z)));
+        }
+
+        const FRotator ViewRotation(-30.0f, 180.0f, 0.0f);
+        auto Measure = [&](auto&& SolveFunction, const TCHAR* Name)
+        {
+            // Первый прогон прогревает пул потоков и кеш
+            FCameraFramingResult Framing = SolveFunction(Buffer, ViewRotation, 90.0f, 16.0f / 9.0f, 10.0f, 5.0f);
+            double BestMs = MAX_dbl;
+            double TotalMs = 0.0;
+            for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+            {
+                const double StartTime = FPlatformTime::Seconds();
+                Framing = SolveFunction(Buffer, ViewRotation, 90.0f, 16.0f / 9.0f, 10.0f, 5.0f);
+                const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+                BestMs = FMath::Min(BestMs, ElapsedMs);
+                TotalMs += ElapsedMs;
+            }
+            UE_LOG(LogTemp, Log, TEXT("[CameraFraming] %s: %d boxes, best %.3f ms, average %.3f ms over %d runs, distance %.1f"),
+                Name, NumBoxes, BestMs, TotalMs / NumIterations, NumIterations, Framing.Distance);
+        };
+
+        Measure(&FCameraFramingSolver::Solve, TEXT("Solve"));
+        Measure(&FCameraFramingSolver::SolveOrbit, TEXT("SolveOrbit"));
+    }
+
+    FAutoConsoleCommand GCameraFramingBenchmarkCommand(
+        TEXT("Camera.Framing.Benchmark"),
+        TEXT("Measures frustum framing on synthetic oriented boxes. Args: [Boxes=100000] [Iterations=20]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunFramingBenchmark));
+}
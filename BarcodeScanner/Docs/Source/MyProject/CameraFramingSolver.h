@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Ориентированные границы целевых акторов в виде структуры массивов (SoA).
+ * Для каждого актора хранится центр и три полуоси с учётом поворота и масштаба.
+ */
+struct SLIMCAPE_API FCameraFramingBuffer
+{
+public:
+    void Reset(int32 ExpectedNum);
+    void Add(const FVector& Center, const FVector& HalfAxisX, const FVector& HalfAxisY, const FVector& HalfAxisZ);
+
+    int32 Num() const { return CenterX.Num(); }
+
+    // Центр общих границ, накапливается при добавлении
+    FVector GetPivotPoint() const { return MergedBounds.IsValid ? MergedBounds.GetCenter() : FVector::ZeroVector; }
+
+    TArray<float> CenterX, CenterY, CenterZ;
+    TArray<float> AxisXX, AxisXY, AxisXZ;
+    TArray<float> AxisYX, AxisYY, AxisYZ;
+    TArray<float> AxisZX, AxisZY, AxisZZ;
+
+private:
+    FBox MergedBounds = FBox(ForceInit);
+};
+
+// Результат подбора позиции камеры
+struct FCameraFramingResult
+{
+    bool bValid = false;
+    FVector FocusPoint = FVector::ZeroVector;
+    FVector CameraLocation = FVector::ZeroVector;
+    float Distance = 0.0f;
+};
+
+/**
+ * Подбирает минимальную дистанцию, при которой все ориентированные границы
+ * попадают в пирамиду видимости камеры с заданным направлением взгляда.
+ * Для каждой боковой плоскости пирамиды считается максимум по всем акторам
+ * (параллельная редукция по блокам), затем точка фокуса сдвигается так,
+ * чтобы левый/правый и верхний/нижний запасы совпали.
+ */
+class SLIMCAPE_API FCameraFramingSolver
+{
+public:
+    static FCameraFramingResult Solve(
+        const FCameraFramingBuffer& Buffer,
+        const FRotator& ViewRotation,
+        float HorizontalFOVDegrees,
+        float AspectRatio,
+        float NearClipDistance,
+        float PaddingPercent);
+
+    /**
+     * Дистанция для облёта по кругу: взгляд с наклоном ViewRotation.Pitch на точку фокуса
+     * при любом рыскании. Каждый бокс заменяется вертикальным цилиндром вокруг оси облёта,
+     * поэтому один проход даёт дистанцию, верную на всём круге. Фокус не сдвигается:
+     * он остаётся на оси. ViewRotation.Yaw задаёт только CameraLocation в результате.
+     */
+    static FCameraFramingResult SolveOrbit(
+        const FCameraFramingBuffer& Buffer,
+        const FRotator& ViewRotation,
+        float HorizontalFOVDegrees,
+        float AspectRatio,
+        float NearClipDistance,
+        float PaddingPercent);
+};
@@ -4,19 +4,21 @@
 #include "CameraPawn.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "CameraProbeSpringArmComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "HAL/PlatformTime.h"
 
 ACameraPawn::ACameraPawn()
 {
     PrimaryActorTick.bCanEverTick = true;
 
-    // Создаем SpringArm компонент
-    SpringArmComponent = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArm"));
+    // Создаем SpringArm компонент с асинхронной проверкой столкновений
+    SpringArmComponent = CreateDefaultSubobject<UCameraProbeSpringArmComponent>(TEXT("SpringArm"));
     RootComponent = SpringArmComponent;
     SpringArmComponent->TargetArmLength = 500.0f;
     SpringArmComponent->bInheritPitch = false;
@@ -91,7 +93,18 @@ void ACameraPawn::Tick(float DeltaTime)
     }
 
     // Обработка автоматического вращения
-    if (CurrentRotationAlpha > 0.0f)
+    FVector TourLocation;
+    FQuat TourRotation;
+    if (CurrentRotationAlpha > 0.0f && bUseCameraTours && UpdateCameraTour(DeltaTime, TourLocation, TourRotation))
+    {
+        // Позиция берётся из запечённой таблицы маршрута без тригонометрии
+        FVector InterpolatedLocation = FMath::Lerp(GetActorLocation(), TourLocation, CurrentRotationAlpha);
+        FQuat InterpolatedRotation = FQuat::Slerp(GetActorQuat(), TourRotation, CurrentRotationAlpha);
+
+        SetActorLocationAndRotation(InterpolatedLocation, InterpolatedRotation);
+        SpringArmComponent->SetWorldRotation(InterpolatedRotation);
+    }
+    else if (CurrentRotationAlpha > 0.0f)
     {
         // Вычисляем новую позицию камеры по кругу
         float CurrentTime = GetWorld()->GetTimeSeconds();
@@ -223,6 +236,103 @@ void ACameraPawn::SetRotationCenter(const FVector& NewCenter)
         NewCenter.X, NewCenter.Y, NewCenter.Z);
 }
 
+void ACameraPawn::BakeCameraTours()
+{
+    BakedTours.Reset();
+    PreviousTourIndex = INDEX_NONE;
+    TourBlendAlpha = 1.0f;
+
+    // Без настроенных маршрутов используем один облёт на текущей высоте. CameraTours не меняем,
+    // чтобы на следующем уровне облёт строился заново по его высоте и центру
+    TArray<FCameraTourSettings> Tours = CameraTours;
+    const bool bDefaultTour = Tours.Num() == 0;
+    if (bDefaultTour)
+    {
+        FCameraTourSettings& DefaultTour = Tours.AddDefaulted_GetRef();
+        DefaultTour.Height = AutoRotationHeight;
+    }
+
+    const FBox Bounds = GetTargetActorsBounds();
+    BakedTours.SetNum(Tours.Num());
+    for (int32 Index = 0; Index < Tours.Num(); ++Index)
+    {
+        if (bDefaultTour && AutoRotationRadius > 0.0f)
+        {
+            // Облёт по умолчанию повторяет настроенное вращение (позиция уровня или расчёт по сцене),
+            // чтобы переключение на маршрут не уводило камеру на край границ
+            const float Radius = FMath::Clamp(AutoRotationRadius, MinRotationRadius, MaxRotationRadius);
+            BakedTours[Index].BuildAroundCenter(Tours[Index], RotationCenter, FVector2D(Radius, Radius), RotationCenter, TourSampleCount);
+        }
+        else
+        {
+            BakedTours[Index].BuildFromBounds(Tours[Index], Bounds, RotationCenter, TourSampleCount);
+        }
+        LOG_CAMERA_INFO("Camera tour %d baked: Length=%.1f, Samples=%d",
+            Index, BakedTours[Index].GetLength(), TourSampleCount);
+    }
+
+    ActiveTourIndex = FMath::Clamp(ActiveTourIndex, 0, BakedTours.Num() - 1);
+}
+
+void ACameraPawn::SetActiveCameraTour(int32 TourIndex)
+{
+    if (!BakedTours.IsValidIndex(TourIndex))
+    {
+        LOG_CAMERA_WARNING("Camera tour %d is not baked", TourIndex);
+        return;
+    }
+
+    if (TourIndex == ActiveTourIndex)
+    {
+        return;
+    }
+
+    // Фаза сохраняется: все маршруты начинаются с одной стороны сцены
+    PreviousTourIndex = ActiveTourIndex;
+    PreviousTourPhase = ActiveTourPhase;
+    ActiveTourIndex = TourIndex;
+    TourBlendAlpha = 0.0f;
+
+    LOG_CAMERA_INFO("Camera tour switched from %d to %d", PreviousTourIndex, ActiveTourIndex);
+}
+
+bool ACameraPawn::UpdateCameraTour(float DeltaTime, FVector& OutLocation, FQuat& OutRotation)
+{
+    if (!BakedTours.IsValidIndex(ActiveTourIndex) || !BakedTours[ActiveTourIndex].IsValid())
+    {
+        return false;
+    }
+
+    const FCameraTourPath& ActiveTour = BakedTours[ActiveTourIndex];
+    ActiveTourPhase = FMath::Frac(ActiveTourPhase + DeltaTime / ActiveTour.GetLoopDuration());
+    ActiveTour.Sample(ActiveTourPhase, OutLocation, OutRotation);
+
+    // Плавный переход с предыдущего маршрута
+    if (BakedTours.IsValidIndex(PreviousTourIndex))
+    {
+        TourBlendAlpha = TourBlendTime > 0.0f ? FMath::Min(TourBlendAlpha + DeltaTime / TourBlendTime, 1.0f) : 1.0f;
+        if (TourBlendAlpha < 1.0f)
+        {
+            const FCameraTourPath& PreviousTour = BakedTours[PreviousTourIndex];
+            PreviousTourPhase = FMath::Frac(PreviousTourPhase + DeltaTime / PreviousTour.GetLoopDuration());
+
+            FVector PreviousLocation;
+            FQuat PreviousRotation;
+            PreviousTour.Sample(PreviousTourPhase, PreviousLocation, PreviousRotation);
+
+            const float BlendAlpha = FMath::SmoothStep(0.0f, 1.0f, TourBlendAlpha);
+            OutLocation = FMath::Lerp(PreviousLocation, OutLocation, BlendAlpha);
+            OutRotation = FQuat::Slerp(PreviousRotation, OutRotation, BlendAlpha);
+        }
+        else
+        {
+            PreviousTourIndex = INDEX_NONE;
+        }
+    }
+
+    return true;
+}
+
 void ACameraPawn::AddCameraPosition(const FString& LevelName, const FVector& Position)
 {
     CameraPositions.Add(LevelName, Position);
@@ -357,8 +467,82 @@ float ACameraPawn::CalculateOptimalRadius() const
     return FMath::Clamp(DesiredRadius, MinRotationRadius, MaxRotationRadius);
 }
 
+void ACameraPawn::GatherTargetOrientedBounds(FCameraFramingBuffer& OutBuffer) const
+{
+    TArray<AActor*> Actors = GetTargetActors();
+    OutBuffer.Reset(Actors.Num());
+
+    for (AActor* Actor : Actors)
+    {
+        if (!Actor)
+        {
+            continue;
+        }
+
+        // Локальные границы с трансформом актора дают ориентированный бокс
+        const FBox LocalBounds = Actor->CalculateComponentsBoundingBoxInLocalSpace();
+        if (!LocalBounds.IsValid)
+        {
+            continue;
+        }
+
+        const FTransform& ActorTransform = Actor->GetActorTransform();
+        const FVector LocalExtent = LocalBounds.GetExtent();
+        OutBuffer.Add(
+            ActorTransform.TransformPosition(LocalBounds.GetCenter()),
+            ActorTransform.TransformVector(FVector(LocalExtent.X, 0.0f, 0.0f)),
+            ActorTransform.TransformVector(FVector(0.0f, LocalExtent.Y, 0.0f)),
+            ActorTransform.TransformVector(FVector(0.0f, 0.0f, LocalExtent.Z)));
+    }
+}
+
+bool ACameraPawn::CalculateFrustumFraming()
+{
+    FCameraFramingBuffer Buffer;
+    GatherTargetOrientedBounds(Buffer);
+
+    // Камера облетает сцену по кругу с постоянным наклоном, поэтому дистанция подбирается
+    // для всех направлений сразу, а не только для FramingViewRotation
+    const double StartTime = FPlatformTime::Seconds();
+    const FCameraFramingResult Framing = FCameraFramingSolver::SolveOrbit(
+        Buffer,
+        FramingViewRotation,
+        CameraComponent->FieldOfView,
+        CameraComponent->AspectRatio,
+        GNearClippingPlane,
+        PaddingPercent);
+    const double SolveMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    if (!Framing.bValid)
+    {
+        LOG_CAMERA_WARNING("Frustum framing failed: no target bounds found");
+        return false;
+    }
+
+    // Камера стоит позади пешки на длину Spring Arm
+    const FRotator ViewRotation(FramingViewRotation.Pitch, FramingViewRotation.Yaw, 0.0f);
+    const FVector Forward = ViewRotation.Vector();
+    const float PawnDistance = FMath::Max(Framing.Distance - SpringArmComponent->TargetArmLength, 1.0f);
+    const FVector PawnOffset = -Forward * PawnDistance;
+
+    SetRotationCenter(Framing.FocusPoint);
+    AutoRotationRadius = FVector2D(PawnOffset.X, PawnOffset.Y).Size();
+    AutoRotationHeight = PawnOffset.Z;
+    SetActorLocationAndRotation(Framing.FocusPoint + PawnOffset, ViewRotation);
+    SpringArmComponent->SetWorldRotation(ViewRotation);
+
+    LOG_CAMERA_INFO("Frustum framing for %d actors in %.3f ms: Distance=%.1f, Radius=%.1f, Height=%.1f",
+        Buffer.Num(), SolveMs, Framing.Distance, AutoRotationRadius, AutoRotationHeight);
+    return true;
+}
+
 void ACameraPawn::CalculateOptimalCameraPosition()
 {
+    if (bUseFrustumFraming && CalculateFrustumFraming())
+    {
+        return;
+    }
+
     FVector Center = CalculateSceneCenter();
     float Radius = CalculateOptimalRadius();
     float Height = CalculateOptimalHeight(GetTargetActorsBounds());
@@ -396,5 +580,11 @@ void ACameraPawn::UpdateCameraForCurrentLevel()
             CalculateOptimalCameraPosition();
             StartAutoRotation();
         }
+
+        // Маршруты облёта запекаются один раз на уровень
+        if (bUseCameraTours)
+        {
+            BakeCameraTours();
+        }
     }
 }
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include "InputActionValue.h"
 #include "Containers/Map.h"
 #include "Math/Box.h"
+#include "CameraTourPath.h"
+#include "CameraFramingSolver.h"
 #include "CameraPawn.generated.h"
 
 // Макросы для логирования
@@ -126,6 +128,32 @@ protected:
     UFUNCTION(BlueprintCallable, Category = "Camera|AutoRotation")
     void SetRotationCenter(const FVector& NewCenter);
 
+    // Маршруты облёта, запекаемые при загрузке уровня
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Tour")
+    bool bUseCameraTours = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Tour")
+    TArray<FCameraTourSettings> CameraTours;
+
+    // Размер таблицы выборки на один маршрут
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Tour", Meta = (ClampMin = "16", ClampMax = "4096"))
+    int32 TourSampleCount = 512;
+
+    // Время плавного перехода между маршрутами (секунды)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Tour", Meta = (ClampMin = "0.0"))
+    float TourBlendTime = 2.0f;
+
+    // Запекает все маршруты по текущим границам сцены
+    UFUNCTION(BlueprintCallable, Category = "Camera|Tour")
+    void BakeCameraTours();
+
+    // Переключает облёт на маршрут с заданным индексом с плавным переходом
+    UFUNCTION(BlueprintCallable, Category = "Camera|Tour")
+    void SetActiveCameraTour(int32 TourIndex);
+
+    UFUNCTION(BlueprintCallable, Category = "Camera|Tour")
+    int32 GetActiveCameraTour() const { return ActiveTourIndex; }
+
     // Позиции камеры для разных уровней
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Camera|Positions")
     TMap<FString, FVector> CameraPositions;
@@ -153,6 +181,14 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|SceneObjects")
     float MaxHeight = 1000.0f;
 
+    // Подбор позиции по пирамиде видимости камеры вместо множителей радиуса и высоты
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|SceneObjects")
+    bool bUseFrustumFraming = false;
+
+    // Наклон взгляда при облёте и начальное направление; дистанция подходит для любого рыскания
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|SceneObjects")
+    FRotator FramingViewRotation = FRotator(-30.0f, 180.0f, 0.0f);
+
     // Функции для работы с объектами сцены
     UFUNCTION(BlueprintCallable, Category = "Camera|SceneObjects")
     void CalculateOptimalCameraPosition();
@@ -192,8 +228,19 @@ private:
     bool bIsMovingToPosition;
     float CurrentTransitionAlpha;
 
+    // Запечённые маршруты и состояние перехода между ними
+    TArray<FCameraTourPath> BakedTours;
+    int32 ActiveTourIndex = 0;
+    int32 PreviousTourIndex = INDEX_NONE;
+    float ActiveTourPhase = 0.0f;
+    float PreviousTourPhase = 0.0f;
+    float TourBlendAlpha = 1.0f;
+
     // Вспомогательные функции
     TArray<AActor*> GetTargetActors() const;
     FBox GetTargetActorsBounds() const;
     float CalculateOptimalHeight(const FBox& Bounds) const;
+    void GatherTargetOrientedBounds(FCameraFramingBuffer& OutBuffer) const;
+    bool CalculateFrustumFraming();
+    bool UpdateCameraTour(float DeltaTime, FVector& OutLocation, FQuat& OutRotation);
 };
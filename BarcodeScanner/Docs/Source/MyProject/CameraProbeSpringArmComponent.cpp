@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CameraProbeSpringArmComponent.h"
+#include "Engine/World.h"
+#include "CollisionQueryParams.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sync Sweep"), STAT_CameraProbe_SyncSweep, STATGROUP_CameraProbe);
+DECLARE_CYCLE_STAT(TEXT("Async Issue"), STAT_CameraProbe_AsyncIssue, STATGROUP_CameraProbe);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Probes Async"), STAT_CameraProbe_Async, STATGROUP_CameraProbe);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Probes Skipped"), STAT_CameraProbe_Skipped, STATGROUP_CameraProbe);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Sweep Time Saved (ms)"), STAT_CameraProbe_SavedMs, STATGROUP_CameraProbe);
+
+UCameraProbeSpringArmComponent::UCameraProbeSpringArmComponent()
+{
+    ProbeTraceDelegate.BindUObject(this, &UCameraProbeSpringArmComponent::OnProbeTraceDone);
+}
+
+void UCameraProbeSpringArmComponent::UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime)
+{
+    if (ProbeMode == ECameraProbeMode::Sync || !bDoTrace || TargetArmLength == 0.0f)
+    {
+        SweepTimeSavedMs = 0.0f;
+        Super::UpdateDesiredArmLocation(bDoTrace, bDoLocationLag, bDoRotationLag, DeltaTime);
+        return;
+    }
+
+    // Положение руки без проверки столкновений (с учётом лага)
+    Super::UpdateDesiredArmLocation(false, bDoLocationLag, bDoRotationLag, DeltaTime);
+
+    const FTransform& ComponentTransform = GetComponentTransform();
+    const FVector Origin = PreviousArmOrigin;
+    const FVector Desired = ComponentTransform.TransformPosition(RelativeSocketLocation);
+
+    const double Now = FPlatformTime::Seconds();
+    const float ThresholdSquared = FMath::Square(ProbeMoveThreshold);
+    const bool bMoved = FVector::DistSquared(Origin, LastProbeOrigin) > ThresholdSquared
+        || FVector::DistSquared(Desired, LastProbeEnd) > ThresholdSquared;
+    const bool bRateAllows = ProbeRate <= 0.0f || (Now - LastProbeTime) >= 1.0 / ProbeRate;
+
+    if (!bHasProbeResult)
+    {
+        // Первый кадр: результата ещё нет, поэтому проверяем синхронно
+        RunSyncProbe(Origin, Desired);
+        SweepTimeSavedMs = 0.0f;
+    }
+    else if (bMoved && bRateAllows && !PendingProbe.IsValid())
+    {
+        const double IssueStart = FPlatformTime::Seconds();
+        IssueAsyncProbe(Origin, Desired);
+        const double IssueCostMs = (FPlatformTime::Seconds() - IssueStart) * 1000.0;
+
+        SweepTimeSavedMs = (float)FMath::Max(SyncSweepCostMs - IssueCostMs, 0.0);
+        INC_DWORD_STAT(STAT_CameraProbe_Async);
+    }
+    else
+    {
+        SweepTimeSavedMs = (float)SyncSweepCostMs;
+        INC_DWORD_STAT(STAT_CameraProbe_Skipped);
+    }
+    INC_FLOAT_STAT_BY(STAT_CameraProbe_SavedMs, SweepTimeSavedMs);
+
+    // Применяем долю длины руки из последнего результата к текущему положению
+    if (LastHitFraction < 1.0f)
+    {
+        const FVector HitLocation = Origin + (Desired - Origin) * LastHitFraction;
+        const FVector ResultLocation = BlendLocations(Desired, HitLocation, true, DeltaTime);
+
+        bIsCameraFixed = ResultLocation != Desired;
+        UnfixedCameraPosition = Desired;
+        RelativeSocketLocation = ComponentTransform.InverseTransformPosition(ResultLocation);
+        UpdateChildTransforms();
+    }
+}
+
+void UCameraProbeSpringArmComponent::IssueAsyncProbe(const FVector& Origin, const FVector& Desired)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CameraProbe_AsyncIssue);
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SpringArm), false, GetOwner());
+    PendingProbe = GetWorld()->AsyncSweepByChannel(
+        EAsyncTraceType::Single,
+        Origin,
+        Desired,
+        FQuat::Identity,
+        ProbeChannel,
+        FCollisionShape::MakeSphere(ProbeSize),
+        QueryParams,
+        FCollisionResponseParams::DefaultResponseParam,
+        &ProbeTraceDelegate);
+
+    LastProbeOrigin = Origin;
+    LastProbeEnd = Desired;
+    LastProbeTime = FPlatformTime::Seconds();
+}
+
+void UCameraProbeSpringArmComponent::RunSyncProbe(const FVector& Origin, const FVector& Desired)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CameraProbe_SyncSweep);
+
+    const double SweepStart = FPlatformTime::Seconds();
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SpringArm), false, GetOwner());
+    FHitResult Result;
+    GetWorld()->SweepSingleByChannel(Result, Origin, Desired, FQuat::Identity, ProbeChannel, FCollisionShape::MakeSphere(ProbeSize), QueryParams);
+
+    SyncSweepCostMs = (FPlatformTime::Seconds() - SweepStart) * 1000.0;
+
+    LastHitFraction = Result.bBlockingHit ? Result.Time : 1.0f;
+    bHasProbeResult = true;
+    LastProbeOrigin = Origin;
+    LastProbeEnd = Desired;
+    LastProbeTime = FPlatformTime::Seconds();
+}
+
+void UCameraProbeSpringArmComponent::OnProbeTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+    if (Handle != PendingProbe)
+    {
+        return;
+    }
+    PendingProbe.Invalidate();
+
+    const FHitResult* BlockingHit = Datum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+    LastHitFraction = BlockingHit ? BlockingHit->Time : 1.0f;
+}
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "WorldCollision.h"
+#include "CameraProbeSpringArmComponent.generated.h"
+
+DECLARE_STATS_GROUP(TEXT("CameraProbe"), STATGROUP_CameraProbe, STATCAT_Advanced);
+
+// Режим проверки столкновений Spring Arm
+UENUM(BlueprintType)
+enum class ECameraProbeMode : uint8
+{
+    Sync    UMETA(DisplayName = "Sync"),    // Стандартный синхронный sweep каждый кадр
+    Async   UMETA(DisplayName = "Async")    // Асинхронный sweep, используется результат прошлого кадра
+};
+
+/**
+ * Spring Arm с бюджетом на проверку столкновений.
+ * В режиме Async sweep отправляется в асинхронную очередь трассировок, а кадр использует
+ * долю длины руки из последнего завершённого результата. Проверка пропускается, если
+ * рука и пешка не сдвинулись дальше порога, и ограничивается частотой ProbeRate.
+ */
+UCLASS(ClassGroup = (Camera), meta = (BlueprintSpawnableComponent))
+class SLIMCAPE_API UCameraProbeSpringArmComponent : public USpringArmComponent
+{
+    GENERATED_BODY()
+
+public:
+    UCameraProbeSpringArmComponent();
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CameraCollision")
+    ECameraProbeMode ProbeMode = ECameraProbeMode::Async;
+
+    // Максимальная частота проверок в секунду (0 - каждый кадр)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CameraCollision", Meta = (ClampMin = "0.0"))
+    float ProbeRate = 30.0f;
+
+    // Сдвиг начала или конца руки, после которого нужна новая проверка
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CameraCollision", Meta = (ClampMin = "0.0"))
+    float ProbeMoveThreshold = 2.0f;
+
+    // Оценка сэкономленного времени sweep за последний кадр (мс)
+    UFUNCTION(BlueprintCallable, Category = "CameraCollision")
+    float GetSweepTimeSavedMs() const { return SweepTimeSavedMs; }
+
+protected:
+    virtual void UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime) override;
+
+private:
+    void IssueAsyncProbe(const FVector& Origin, const FVector& Desired);
+    void RunSyncProbe(const FVector& Origin, const FVector& Desired);
+    void OnProbeTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+    FTraceDelegate ProbeTraceDelegate;
+    FTraceHandle PendingProbe;
+
+    // Доля длины руки до препятствия из последнего результата (1 - препятствия нет)
+    float LastHitFraction = 1.0f;
+    bool bHasProbeResult = false;
+
+    FVector LastProbeOrigin = FVector::ZeroVector;
+    FVector LastProbeEnd = FVector::ZeroVector;
+    double LastProbeTime = 0.0;
+
+    // Стоимость последнего синхронного sweep, используется для оценки экономии
+    double SyncSweepCostMs = 0.0;
+    float SweepTimeSavedMs = 0.0f;
+};
@@ -0,0 +1,165 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CameraTourPath.h"
+#include "Math/RotationMatrix.h"
+
+namespace
+{
+    // Количество промежуточных точек на сегмент при измерении длины дуги
+    constexpr int32 ArcLengthSubSteps = 16;
+
+    FVector CatmullRom(const FVector& P0, const FVector& P1, const FVector& P2, const FVector& P3, float T)
+    {
+        const float T2 = T * T;
+        const float T3 = T2 * T;
+        return 0.5f * ((2.0f * P1)
+            + (P2 - P0) * T
+            + (2.0f * P0 - 5.0f * P1 + 4.0f * P2 - P3) * T2
+            + (3.0f * P1 - P0 - 3.0f * P2 + P3) * T3);
+    }
+}
+
+void FCameraTourPath::BuildFromBounds(const FCameraTourSettings& Settings, const FBox& SceneBounds, const FVector& LookAtTarget, int32 SampleCount)
+{
+    // Если границы не найдены, строим маршрут вокруг точки взгляда
+    const FVector Center = SceneBounds.IsValid ? SceneBounds.GetCenter() : LookAtTarget;
+    const FVector Extent = SceneBounds.IsValid ? SceneBounds.GetExtent() : FVector(500.0f);
+
+    // Эллипс повторяет пропорции сцены, поэтому длинные стеллажи облетаются ближе
+    BuildAroundCenter(Settings, Center, FVector2D(FMath::Max(Extent.X, 100.0f), FMath::Max(Extent.Y, 100.0f)), LookAtTarget, SampleCount);
+}
+
+void FCameraTourPath::BuildAroundCenter(const FCameraTourSettings& Settings, const FVector& Center, const FVector2D& Radii, const FVector& LookAtTarget, int32 SampleCount)
+{
+    LoopDuration = FMath::Max(Settings.LoopDuration, 1.0f);
+
+    const float RadiusX = Radii.X * Settings.RadiusScale;
+    const float RadiusY = Radii.Y * Settings.RadiusScale;
+
+    const int32 PointCount = FMath::Clamp(Settings.ControlPointCount, 4, 64);
+    TArray<FVector> ControlPoints;
+    ControlPoints.Reserve(PointCount);
+
+    // Тригонометрия считается только здесь, при запекании
+    for (int32 Index = 0; Index < PointCount; ++Index)
+    {
+        const float Angle = 2.0f * PI * Index / PointCount;
+        float SinAngle, CosAngle;
+        FMath::SinCos(&SinAngle, &CosAngle, Angle);
+
+        FVector Offset;
+        if (Settings.Type == ECameraTourType::FlyThrough)
+        {
+            // Восьмёрка проходит через центр сцены
+            Offset = FVector(CosAngle * RadiusX, SinAngle * CosAngle * RadiusY, Settings.Height);
+        }
+        else
+        {
+            Offset = FVector(CosAngle * RadiusX, SinAngle * RadiusY, Settings.Height);
+        }
+        ControlPoints.Add(Center + Offset);
+    }
+
+    Bake(ControlPoints, LookAtTarget, SampleCount);
+}
+
+void FCameraTourPath::Bake(const TArray<FVector>& ControlPoints, const FVector& LookAtTarget, int32 SampleCount)
+{
+    Locations.Reset();
+    Rotations.Reset();
+    Length = 0.0f;
+
+    const int32 PointCount = ControlPoints.Num();
+    if (PointCount < 3 || SampleCount < 2)
+    {
+        return;
+    }
+
+    // Плотная выборка сплайна с накопленной длиной дуги
+    const int32 DenseCount = PointCount * ArcLengthSubSteps;
+    TArray<FVector> DensePoints;
+    TArray<float> DenseDistances;
+    DensePoints.Reserve(DenseCount + 1);
+    DenseDistances.Reserve(DenseCount + 1);
+
+    for (int32 Segment = 0; Segment < PointCount; ++Segment)
+    {
+        const FVector& P0 = ControlPoints[(Segment + PointCount - 1) % PointCount];
+        const FVector& P1 = ControlPoints[Segment];
+        const FVector& P2 = ControlPoints[(Segment + 1) % PointCount];
+        const FVector& P3 = ControlPoints[(Segment + 2) % PointCount];
+
+        for (int32 Step = 0; Step < ArcLengthSubSteps; ++Step)
+        {
+            const FVector Point = CatmullRom(P0, P1, P2, P3, (float)Step / ArcLengthSubSteps);
+            if (DensePoints.Num() > 0)
+            {
+                Length += FVector::Dist(DensePoints.Last(), Point);
+            }
+            DensePoints.Add(Point);
+            DenseDistances.Add(Length);
+        }
+    }
+
+    // Замыкаем петлю на первую точку
+    Length += FVector::Dist(DensePoints.Last(), DensePoints[0]);
+    DensePoints.Add(DensePoints[0]);
+    DenseDistances.Add(Length);
+
+    if (Length <= KINDA_SMALL_NUMBER)
+    {
+        return;
+    }
+
+    // Перевыборка с равным шагом по длине дуги
+    Locations.Reserve(SampleCount);
+    Rotations.Reserve(SampleCount);
+
+    int32 DenseIndex = 0;
+    for (int32 SampleIndex = 0; SampleIndex < SampleCount; ++SampleIndex)
+    {
+        const float TargetDistance = Length * SampleIndex / SampleCount;
+        while (DenseIndex < DensePoints.Num() - 2 && DenseDistances[DenseIndex + 1] < TargetDistance)
+        {
+            ++DenseIndex;
+        }
+
+        const float SegmentLength = DenseDistances[DenseIndex + 1] - DenseDistances[DenseIndex];
+        const float Alpha = SegmentLength > KINDA_SMALL_NUMBER
+            ? (TargetDistance - DenseDistances[DenseIndex]) / SegmentLength
+            : 0.0f;
+
+        const FVector Location = FMath::Lerp(DensePoints[DenseIndex], DensePoints[DenseIndex + 1], Alpha);
+        Locations.Add(Location);
+
+        // Пролёт через центр на нулевой высоте попадает в саму точку взгляда: смотрим вдоль маршрута
+        FVector LookDirection = LookAtTarget - Location;
+        if (LookDirection.IsNearlyZero())
+        {
+            LookDirection = DensePoints[DenseIndex + 1] - DensePoints[DenseIndex];
+        }
+        if (LookDirection.IsNearlyZero())
+        {
+            LookDirection = Rotations.Num() > 0 ? Rotations.Last().GetForwardVector() : FVector::ForwardVector;
+        }
+        Rotations.Add(FRotationMatrix::MakeFromX(LookDirection).ToQuat());
+    }
+}
+
+void FCameraTourPath::Sample(float Phase, FVector& OutLocation, FQuat& OutRotation) const
+{
+    const int32 Count = Locations.Num();
+    if (Count == 0)
+    {
+        return;
+    }
+
+    const float Position = FMath::Frac(Phase) * Count;
+    const int32 Index0 = FMath::Min(FMath::FloorToInt(Position), Count - 1);
+    const int32 Index1 = (Index0 + 1) % Count;
+    const float Alpha = Position - Index0;
+
+    OutLocation = FMath::Lerp(Locations[Index0], Locations[Index1], Alpha);
+    OutRotation = FQuat::Slerp(Rotations[Index0], Rotations[Index1], Alpha);
+}
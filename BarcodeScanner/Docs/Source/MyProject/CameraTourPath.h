@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Box.h"
+#include "CameraTourPath.generated.h"
+
+// Тип маршрута облёта камеры
+UENUM(BlueprintType)
+enum class ECameraTourType : uint8
+{
+    Orbit       UMETA(DisplayName = "Orbit"),       // Эллипс вокруг сцены
+    FlyThrough  UMETA(DisplayName = "Fly Through")  // Восьмёрка сквозь сцену
+};
+
+// Настройки одного маршрута облёта
+USTRUCT(BlueprintType)
+struct FCameraTourSettings
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Tour")
+    ECameraTourType Type = ECameraTourType::Orbit;
+
+    // Время одного полного круга по маршруту (секунды)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Tour", Meta = (ClampMin = "1.0"))
+    float LoopDuration = 30.0f;
+
+    // Количество опорных точек сплайна
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Tour", Meta = (ClampMin = "4", ClampMax = "64"))
+    int32 ControlPointCount = 12;
+
+    // Множитель радиуса относительно границ сцены
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Tour", Meta = (ClampMin = "0.1", ClampMax = "4.0"))
+    float RadiusScale = 1.0f;
+
+    // Высота маршрута относительно центра сцены
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Tour")
+    float Height = 200.0f;
+};
+
+/**
+ * Маршрут камеры, запечённый в таблицу равномерно распределённых по длине дуги точек.
+ * Опорные точки соединяются сплайном Catmull-Rom один раз при загрузке уровня,
+ * после чего выборка позиции и поворота за кадр - это чтение двух соседних ячеек таблицы.
+ */
+struct SLIMCAPE_API FCameraTourPath
+{
+public:
+    // Строит опорные точки маршрута по границам сцены и запекает таблицу
+    void BuildFromBounds(const FCameraTourSettings& Settings, const FBox& SceneBounds, const FVector& LookAtTarget, int32 SampleCount);
+
+    // Строит маршрут вокруг заданного центра с полуосями Radii (до RadiusScale) и запекает таблицу
+    void BuildAroundCenter(const FCameraTourSettings& Settings, const FVector& Center, const FVector2D& Radii, const FVector& LookAtTarget, int32 SampleCount);
+
+    // Запекает замкнутый сплайн через опорные точки в таблицу из SampleCount точек
+    void Bake(const TArray<FVector>& ControlPoints, const FVector& LookAtTarget, int32 SampleCount);
+
+    // Выборка по нормализованной фазе [0, 1) за постоянное время
+    void Sample(float Phase, FVector& OutLocation, FQuat& OutRotation) const;
+
+    bool IsValid() const { return Locations.Num() > 1; }
+    float GetLength() const { return Length; }
+    float GetLoopDuration() const { return LoopDuration; }
+
+private:
+    // Позиции и повороты в равных шагах по длине дуги
+    TArray<FVector> Locations;
+    TArray<FQuat> Rotations;
+
+    float Length = 0.0f;
+    float LoopDuration = 30.0f;
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+// Раскладка кольца сканирований в разделяемой памяти POSIX.
+// Общая для писателя (FScanShmExporter в плагине) и читателей; только стандартный C++.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ScanShm
+{
+    constexpr uint32_t Magic = 0x4D485342; // "BSHM"
+    constexpr uint32_t Version = 1;
+    constexpr const char* DefaultName = "/barcode_scanner_scans";
+
+    constexpr uint32_t MaxCodeBytes = 128;
+    constexpr uint32_t MaxDeviceIdBytes = 48;
+    constexpr uint32_t MaxSymbologyBytes = 8;
+
+    // Состояние писателя: читатели переоткрывают сегмент после Closed
+    enum class EWriterState : uint32_t
+    {
+        Initializing = 0,
+        Active = 1,
+        Closed = 2
+    };
+
+    /**
+     * Слот кольца. Sequence работает как seqlock: (N << 1) | 1 - запись N в процессе,
+     * N << 1 - запись N опубликована. Читатель сверяет Sequence до и после копирования.
+     */
+    struct alignas(64) FSlot
+    {
+        std::atomic<uint64_t> Sequence;
+
+        int64_t ScanSequenceNumber;     // FBarcodeScanRecord::SequenceNumber
+        int64_t TimestampUnixNs;        // Время сканирования, наносекунды UNIX (UTC)
+        uint16_t CodeLength;            // Длины в байтах UTF-8, без завершающего нуля
+        uint8_t DeviceIdLength;
+        uint8_t SymbologyLength;
+        char Code[MaxCodeBytes];
+        char DeviceId[MaxDeviceIdBytes];
+        char Symbology[MaxSymbologyBytes];
+    };
+
+    struct alignas(64) FHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t SlotCount;             // Степень двойки
+        uint32_t SlotSize;              // sizeof(FSlot) писателя, для проверки совместимости
+        std::atomic<uint32_t> WriterState;
+        int32_t WriterPid;
+
+        // Номер последней опубликованной записи; записи нумеруются с 1
+        alignas(64) std::atomic<uint64_t> WriteSequence;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory ring requires lock-free 64-bit atomics");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared memory ring requires lock-free 32-bit atomics");
+
+    inline size_t GetSegmentSize(uint32_t SlotCount)
+    {
+        return sizeof(FHeader) + sizeof(FSlot) * static_cast<size_t>(SlotCount);
+    }
+
+    inline FSlot* GetSlots(FHeader* Header)
+    {
+        return reinterpret_cast<FSlot*>(reinterpret_cast<uint8_t*>(Header) + sizeof(FHeader));
+    }
+
+    inline const FSlot* GetSlots(const FHeader* Header)
+    {
+        return reinterpret_cast<const FSlot*>(reinterpret_cast<const uint8_t*>(Header) + sizeof(FHeader));
+    }
+
+    /**
+     * Публикация записи Sequence (номера с 1, без пропусков) единственным писателем.
+     * FillPayload(FSlot&) заполняет поля записи; метка seqlock, барьеры и WriteSequence - здесь,
+     * чтобы экспортёр плагина и тесты писали кольцо одним и тем же кодом.
+     */
+    template <typename FillFunctionType>
+    inline void PublishSlot(FHeader* Header, FSlot* Slots, uint64_t Sequence, FillFunctionType&& FillPayload)
+    {
+        FSlot& Slot = Slots[Sequence & (static_cast<uint64_t>(Header->SlotCount) - 1)];
+
+        // Нечётная метка предупреждает читателей, что слот переписывается
+        Slot.Sequence.store((Sequence << 1) | 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        FillPayload(Slot);
+
+        Slot.Sequence.store(Sequence << 1, std::memory_order_release);
+        Header->WriteSequence.store(Sequence, std::memory_order_release);
+    }
+}
@@ -0,0 +1,154 @@
+#include "ScanShmReader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ScanShm
+{
+    FScanShmReader::~FScanShmReader()
+    {
+        Close();
+    }
+
+    bool FScanShmReader::Open(const char* Name, bool bFromOldest)
+    {
+        Close();
+
+        const int Fd = shm_open(Name, O_RDONLY, 0);
+        if (Fd < 0)
+        {
+            LastError = std::string("shm_open failed: ") + std::strerror(errno);
+            return false;
+        }
+
+        struct stat Stat {};
+        if (fstat(Fd, &Stat) != 0 || static_cast<size_t>(Stat.st_size) < sizeof(FHeader))
+        {
+            LastError = "segment is too small";
+            close(Fd);
+            return false;
+        }
+
+        void* Mapping = mmap(nullptr, static_cast<size_t>(Stat.st_size), PROT_READ, MAP_SHARED, Fd, 0);
+        close(Fd);
+        if (Mapping == MAP_FAILED)
+        {
+            LastError = std::string("mmap failed: ") + std::strerror(errno);
+            return false;
+        }
+
+        const FHeader* Mapped = static_cast<const FHeader*>(Mapping);
+        const uint32_t State = Mapped->WriterState.load(std::memory_order_acquire);
+        const bool bValid = State == static_cast<uint32_t>(EWriterState::Active)
+            && Mapped->Magic == Magic
+            && Mapped->Version == Version
+            && Mapped->SlotSize == sizeof(FSlot)
+            && Mapped->SlotCount != 0
+            && (Mapped->SlotCount & (Mapped->SlotCount - 1)) == 0
+            && GetSegmentSize(Mapped->SlotCount) <= static_cast<size_t>(Stat.st_size);
+        if (!bValid)
+        {
+            LastError = "segment is not an active scan ring of a compatible version";
+            munmap(Mapping, static_cast<size_t>(Stat.st_size));
+            return false;
+        }
+
+        Header = Mapped;
+        Slots = GetSlots(Header);
+        MappedSize = static_cast<size_t>(Stat.st_size);
+        Mask = Header->SlotCount - 1;
+        LostCount = 0;
+
+        const uint64_t Written = Header->WriteSequence.load(std::memory_order_acquire);
+        NextSequence = Written + 1;
+        if (bFromOldest)
+        {
+            NextSequence = Written >= Header->SlotCount ? Written - Header->SlotCount + 1 : 1;
+        }
+        return true;
+    }
+
+    void FScanShmReader::Close()
+    {
+        if (Header)
+        {
+            munmap(const_cast<FHeader*>(Header), MappedSize);
+            Header = nullptr;
+            Slots = nullptr;
+            MappedSize = 0;
+        }
+    }
+
+    EReadResult FScanShmReader::TryRead(FScanRecord& OutRecord)
+    {
+        if (!Header)
+        {
+            return EReadResult::WriterClosed;
+        }
+
+        uint64_t Written = Header->WriteSequence.load(std::memory_order_acquire);
+        if (NextSequence > Written)
+        {
+            // Закрытие проверяем только когда всё прочитано, чтобы не терять хвост
+            if (Header->WriterState.load(std::memory_order_acquire) != static_cast<uint32_t>(EWriterState::Closed))
+            {
+                return EReadResult::Empty;
+            }
+
+            // Писатель мог дописать записи между чтением WriteSequence и состояния; после Closed номер окончательный
+            Written = Header->WriteSequence.load(std::memory_order_acquire);
+            if (NextSequence > Written)
+            {
+                return EReadResult::WriterClosed;
+            }
+        }
+
+        const uint64_t SlotCount = Mask + 1;
+        if (Written - NextSequence >= SlotCount)
+        {
+            const uint64_t Oldest = Written - SlotCount + 1;
+            LostCount += Oldest - NextSequence;
+            NextSequence = Oldest;
+            return EReadResult::Overrun;
+        }
+
+        const FSlot& Slot = Slots[NextSequence & Mask];
+        const uint64_t Expected = NextSequence << 1;
+        const uint64_t Before = Slot.Sequence.load(std::memory_order_acquire);
+        if (Before != Expected)
+        {
+            // Слот уже занят более новой записью: читатель отстал за время между проверками
+            LostCount += 1;
+            NextSequence += 1;
+            return EReadResult::Overrun;
+        }
+
+        const int64_t ScanSequenceNumber = Slot.ScanSequenceNumber;
+        const int64_t TimestampUnixNs = Slot.TimestampUnixNs;
+        const uint16_t CodeLength = std::min<uint16_t>(Slot.CodeLength, MaxCodeBytes);
+        const uint8_t DeviceIdLength = std::min<uint8_t>(Slot.DeviceIdLength, MaxDeviceIdBytes);
+        const uint8_t SymbologyLength = std::min<uint8_t>(Slot.SymbologyLength, MaxSymbologyBytes);
+        OutRecord.Code.assign(Slot.Code, CodeLength);
+        OutRecord.DeviceId.assign(Slot.DeviceId, DeviceIdLength);
+        OutRecord.Symbology.assign(Slot.Symbology, SymbologyLength);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (Slot.Sequence.load(std::memory_order_relaxed) != Expected)
+        {
+            LostCount += 1;
+            NextSequence += 1;
+            return EReadResult::Overrun;
+        }
+
+        OutRecord.RingSequence = NextSequence;
+        OutRecord.ScanSequenceNumber = ScanSequenceNumber;
+        OutRecord.TimestampUnixNs = TimestampUnixNs;
+        NextSequence += 1;
+        return EReadResult::Ok;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ScanShmLayout.h"
+#include <cstdint>
+#include <string>
+
+namespace ScanShm
+{
+    // Копия одной записи кольца
+    struct FScanRecord
+    {
+        uint64_t RingSequence = 0;      // Номер записи в кольце, без пропусков у писателя
+        int64_t ScanSequenceNumber = 0;
+        int64_t TimestampUnixNs = 0;
+        std::string Code;
+        std::string DeviceId;
+        std::string Symbology;
+    };
+
+    enum class EReadResult
+    {
+        Ok,             // Запись прочитана
+        Empty,          // Новых записей нет
+        Overrun,        // Писатель обогнал читателя; чтение продолжено с самой старой доступной записи
+        WriterClosed    // Писатель закрыл сегмент; нужно переоткрыть
+    };
+
+    /**
+     * Читатель кольца сканирований. Каждый читатель ведёт свою позицию и не влияет
+     * на писателя и других читателей. TryRead не делает системных вызовов.
+     * Экземпляр не потокобезопасен: один читатель - один поток.
+     */
+    class FScanShmReader
+    {
+    public:
+        FScanShmReader() = default;
+        ~FScanShmReader();
+
+        FScanShmReader(const FScanShmReader&) = delete;
+        FScanShmReader& operator=(const FScanShmReader&) = delete;
+
+        // Подключается к сегменту; bFromOldest - начать с самой старой записи кольца, иначе только новые
+        bool Open(const char* Name = DefaultName, bool bFromOldest = false);
+        void Close();
+        bool IsOpen() const { return Header != nullptr; }
+
+        EReadResult TryRead(FScanRecord& OutRecord);
+
+        // Номер следующей ожидаемой записи
+        uint64_t GetNextSequence() const { return NextSequence; }
+
+        // Записи, потерянные из-за переполнения, за всё время чтения
+        uint64_t GetLostCount() const { return LostCount; }
+
+        const std::string& GetLastError() const { return LastError; }
+
+    private:
+        const FHeader* Header = nullptr;
+        const FSlot* Slots = nullptr;
+        size_t MappedSize = 0;
+        uint64_t Mask = 0;
+        uint64_t NextSequence = 1;
+        uint64_t LostCount = 0;
+        std::string LastError;
+    };
+}
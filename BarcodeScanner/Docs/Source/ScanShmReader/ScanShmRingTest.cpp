@@ -0,0 +1,253 @@
+// Проверка кольца двумя процессами: писатель через ScanShm::PublishSlot (его же вызывает
+// FScanShmExporter) и читатель FScanShmReader в дочернем процессе.
+// Использование: ScanShmRingTest [записей] [минимум записей в секунду]
+//
+// Прогон с ожиданием читателя: все номера должны прийти по порядку без пропусков, сквозная
+// скорость - не ниже минимума. Прогон без ожидания: читатель отстаёт, но прочитанное вместе
+// с потерянным равно записанному, а номера только растут.
+
+#include "ScanShmReader.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+
+namespace
+{
+    constexpr uint32_t RingSize = 4096;
+    constexpr int TimeoutSeconds = 60;
+    constexpr uint64_t ProgressBatch = 64;
+
+    // Общий для процессов блок управления; в сегмент сканера не входит
+    struct FControl
+    {
+        alignas(64) std::atomic<uint64_t> ReaderNext;  // Следующая ожидаемая читателем запись
+        alignas(64) std::atomic<uint32_t> bReaderReady;
+        std::atomic<uint64_t> Received;
+        std::atomic<uint64_t> Lost;
+        std::atomic<uint64_t> Errors;
+    };
+
+    // Читатель: проверяет порядок и содержимое, итог кладёт в Control
+    int RunReader(const char* Name, FControl* Control, bool bPaced)
+    {
+        ScanShm::FScanShmReader Reader;
+        const auto OpenDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!Reader.Open(Name, true))
+        {
+            if (std::chrono::steady_clock::now() > OpenDeadline)
+            {
+                std::fprintf(stderr, "reader: %s\n", Reader.GetLastError().c_str());
+                return 1;
+            }
+            std::this_thread::yield();
+        }
+        Control->bReaderReady.store(1, std::memory_order_release);
+
+        ScanShm::FScanRecord Record;
+        uint64_t Received = 0;
+        uint64_t Errors = 0;
+        uint64_t LastSequence = 0;
+        for (;;)
+        {
+            const ScanShm::EReadResult Result = Reader.TryRead(Record);
+            if (Result == ScanShm::EReadResult::Ok)
+            {
+                ++Received;
+                const bool bInOrder = bPaced ? Record.RingSequence == LastSequence + 1 : Record.RingSequence > LastSequence;
+                char ExpectedCode[32];
+                const int ExpectedLength = std::snprintf(ExpectedCode, sizeof(ExpectedCode), "CODE%llu", static_cast<unsigned long long>(Record.RingSequence));
+                const bool bIntact = static_cast<uint64_t>(Record.ScanSequenceNumber) == Record.RingSequence
+                    && Record.Code.compare(0, std::string::npos, ExpectedCode, ExpectedLength) == 0;
+                if (!bInOrder || !bIntact)
+                {
+                    if (Errors++ == 0)
+                    {
+                        std::fprintf(stderr, "reader: record %llu after %llu, code '%s'\n",
+                            static_cast<unsigned long long>(Record.RingSequence),
+                            static_cast<unsigned long long>(LastSequence), Record.Code.c_str());
+                    }
+                }
+                LastSequence = Record.RingSequence;
+
+                // Позиция публикуется пачками, чтобы не гонять строку кеша между процессами на каждой записи
+                if ((Received & (ProgressBatch - 1)) == 0)
+                {
+                    Control->ReaderNext.store(Reader.GetNextSequence(), std::memory_order_release);
+                }
+            }
+            else if (Result == ScanShm::EReadResult::Overrun)
+            {
+                // Писатель ждёт читателя, переполнения быть не должно
+                if (bPaced && Errors++ == 0)
+                {
+                    std::fprintf(stderr, "reader: overrun at %llu\n", static_cast<unsigned long long>(Reader.GetNextSequence()));
+                }
+            }
+            else if (Result == ScanShm::EReadResult::WriterClosed)
+            {
+                break;
+            }
+            else
+            {
+                Control->ReaderNext.store(Reader.GetNextSequence(), std::memory_order_release);
+                std::this_thread::yield();
+            }
+        }
+
+        Control->Received.store(Received, std::memory_order_relaxed);
+        Control->Lost.store(Reader.GetLostCount(), std::memory_order_relaxed);
+        Control->Errors.store(Errors, std::memory_order_relaxed);
+        return Errors == 0 ? 0 : 1;
+    }
+
+    // Публикация через ScanShm::PublishSlot - тот же код, что в FScanShmExporter::Publish
+    void Publish(ScanShm::FHeader* Header, ScanShm::FSlot* Slots, uint64_t Sequence)
+    {
+        ScanShm::PublishSlot(Header, Slots, Sequence, [Sequence](ScanShm::FSlot& Slot)
+        {
+            Slot.ScanSequenceNumber = static_cast<int64_t>(Sequence);
+            Slot.TimestampUnixNs = 0;
+            Slot.CodeLength = static_cast<uint16_t>(std::snprintf(Slot.Code, ScanShm::MaxCodeBytes, "CODE%llu", static_cast<unsigned long long>(Sequence)));
+            Slot.DeviceIdLength = 0;
+            Slot.SymbologyLength = 0;
+        });
+    }
+
+    // Один прогон; возвращает записей в секунду от первой публикации до выхода читателя, 0 - ошибка
+    double RunPass(uint64_t Records, bool bPaced)
+    {
+        const std::string Name = "/scan_shm_ring_test_" + std::to_string(getpid());
+        const size_t SegmentSize = ScanShm::GetSegmentSize(RingSize);
+
+        shm_unlink(Name.c_str());
+        const int Fd = shm_open(Name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (Fd < 0 || ftruncate(Fd, static_cast<off_t>(SegmentSize)) != 0)
+        {
+            std::perror("shm_open");
+            return 0.0;
+        }
+        void* Mapping = mmap(nullptr, SegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+        close(Fd);
+        void* ControlMapping = mmap(nullptr, sizeof(FControl), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (Mapping == MAP_FAILED || ControlMapping == MAP_FAILED)
+        {
+            std::perror("mmap");
+            shm_unlink(Name.c_str());
+            return 0.0;
+        }
+
+        ScanShm::FHeader* Header = static_cast<ScanShm::FHeader*>(Mapping);
+        Header->Magic = ScanShm::Magic;
+        Header->Version = ScanShm::Version;
+        Header->SlotCount = RingSize;
+        Header->SlotSize = sizeof(ScanShm::FSlot);
+        Header->WriterPid = static_cast<int32_t>(getpid());
+        Header->WriteSequence.store(0, std::memory_order_relaxed);
+        Header->WriterState.store(static_cast<uint32_t>(ScanShm::EWriterState::Active), std::memory_order_release);
+        ScanShm::FSlot* Slots = ScanShm::GetSlots(Header);
+
+        FControl* Control = new (ControlMapping) FControl();
+        Control->ReaderNext.store(1, std::memory_order_relaxed);
+
+        const pid_t ReaderPid = fork();
+        if (ReaderPid == 0)
+        {
+            alarm(TimeoutSeconds);
+            _exit(RunReader(Name.c_str(), Control, bPaced));
+        }
+
+        bool bWriterOk = ReaderPid > 0;
+        const auto ReadyDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (bWriterOk && !Control->bReaderReady.load(std::memory_order_acquire))
+        {
+            bWriterOk = std::chrono::steady_clock::now() < ReadyDeadline;
+            std::this_thread::yield();
+        }
+
+        const auto Start = std::chrono::steady_clock::now();
+        uint64_t ReaderNext = 1;
+        for (uint64_t Sequence = 1; bWriterOk && Sequence <= Records; ++Sequence)
+        {
+            // Слот Sequence - RingSize должен быть уже прочитан
+            while (bPaced && Sequence - ReaderNext >= RingSize)
+            {
+                ReaderNext = Control->ReaderNext.load(std::memory_order_acquire);
+                if (Sequence - ReaderNext < RingSize)
+                {
+                    break;
+                }
+                // На одном ядре без уступки читатель не получит процессор до конца кванта
+                std::this_thread::yield();
+                if (std::chrono::steady_clock::now() - Start > std::chrono::seconds(TimeoutSeconds))
+                {
+                    std::fprintf(stderr, "writer: reader stalled at %llu\n",
+                        static_cast<unsigned long long>(Control->ReaderNext.load(std::memory_order_relaxed)));
+                    bWriterOk = false;
+                    break;
+                }
+            }
+            if (bWriterOk)
+            {
+                Publish(Header, Slots, Sequence);
+            }
+        }
+        Header->WriterState.store(static_cast<uint32_t>(ScanShm::EWriterState::Closed), std::memory_order_release);
+
+        int Status = 1;
+        const bool bReaderOk = ReaderPid > 0 && waitpid(ReaderPid, &Status, 0) == ReaderPid && WIFEXITED(Status) && WEXITSTATUS(Status) == 0;
+        const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+        const uint64_t Received = Control->Received.load(std::memory_order_relaxed);
+        const uint64_t Lost = Control->Lost.load(std::memory_order_relaxed);
+        std::printf("%s: %llu records, received %llu, lost %llu, errors %llu, %.0f records/s\n",
+            bPaced ? "paced" : "unpaced",
+            static_cast<unsigned long long>(Records), static_cast<unsigned long long>(Received),
+            static_cast<unsigned long long>(Lost), static_cast<unsigned long long>(Control->Errors.load(std::memory_order_relaxed)),
+            Records / Seconds);
+
+        munmap(ControlMapping, sizeof(FControl));
+        munmap(Mapping, SegmentSize);
+        shm_unlink(Name.c_str());
+
+        const bool bCountsMatch = bPaced ? Received == Records && Lost == 0 : Received + Lost == Records;
+        if (!bWriterOk || !bReaderOk || !bCountsMatch)
+        {
+            return 0.0;
+        }
+        return Records / Seconds;
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    const uint64_t Records = Argc > 1 ? std::strtoull(Argv[1], nullptr, 10) : 2000000;
+    const double MinRecordsPerSecond = Argc > 2 ? std::strtod(Argv[2], nullptr) : 1000000.0;
+
+    const double PacedRate = RunPass(Records, true);
+    if (PacedRate <= 0.0)
+    {
+        std::fprintf(stderr, "FAILED: paced pass lost or reordered records\n");
+        return 1;
+    }
+    if (PacedRate < MinRecordsPerSecond)
+    {
+        std::fprintf(stderr, "FAILED: %.0f records/s is below the required %.0f\n", PacedRate, MinRecordsPerSecond);
+        return 1;
+    }
+
+    if (RunPass(Records, false) <= 0.0)
+    {
+        std::fprintf(stderr, "FAILED: unpaced pass miscounted lost records\n");
+        return 1;
+    }
+    return 0;
+}
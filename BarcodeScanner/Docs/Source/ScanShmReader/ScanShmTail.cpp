@@ -0,0 +1,44 @@
+// Пример читателя: печатает сканирования из кольца и сообщает о потерях.
+// Использование: ScanShmTail [имя сегмента]
+
+#include "ScanShmReader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+int main(int Argc, char** Argv)
+{
+    const char* Name = Argc > 1 ? Argv[1] : ScanShm::DefaultName;
+
+    ScanShm::FScanShmReader Reader;
+    ScanShm::FScanRecord Record;
+    for (;;)
+    {
+        if (!Reader.IsOpen() && !Reader.Open(Name))
+        {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            continue;
+        }
+
+        switch (Reader.TryRead(Record))
+        {
+        case ScanShm::EReadResult::Ok:
+            std::printf("%llu\t%lld\t%s\t%s\t%s\n",
+                static_cast<unsigned long long>(Record.RingSequence),
+                static_cast<long long>(Record.ScanSequenceNumber),
+                Record.DeviceId.c_str(), Record.Symbology.c_str(), Record.Code.c_str());
+            break;
+        case ScanShm::EReadResult::Overrun:
+            std::fprintf(stderr, "overrun, lost %llu records in total\n", static_cast<unsigned long long>(Reader.GetLostCount()));
+            break;
+        case ScanShm::EReadResult::WriterClosed:
+            Reader.Close();
+            break;
+        case ScanShm::EReadResult::Empty:
+            // Опрос без системных вызовов дорог для процессора; пауза - компромисс для примера
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            break;
+        }
+    }
+}